@@ -0,0 +1,194 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WCBlit.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+#define WC_BLIT_SSE2 1
+#include <emmintrin.h>
+#else
+#define WC_BLIT_SSE2 0
+#endif
+
+namespace
+{
+  const int SIMD_SIZE = 8;
+
+#if WC_BLIT_SSE2
+  // 8x8 transpose of 16 bit values, rows are read from src and written as columns to dst
+  FORCEINLINE void Transpose8x8(const uint16* src, int64 srcStride, uint16* dst, int64 dstStride)
+  {
+    const __m128i r0 = _mm_loadu_si128((const __m128i*)(src));
+    const __m128i r1 = _mm_loadu_si128((const __m128i*)(src + srcStride));
+    const __m128i r2 = _mm_loadu_si128((const __m128i*)(src + srcStride * 2));
+    const __m128i r3 = _mm_loadu_si128((const __m128i*)(src + srcStride * 3));
+    const __m128i r4 = _mm_loadu_si128((const __m128i*)(src + srcStride * 4));
+    const __m128i r5 = _mm_loadu_si128((const __m128i*)(src + srcStride * 5));
+    const __m128i r6 = _mm_loadu_si128((const __m128i*)(src + srcStride * 6));
+    const __m128i r7 = _mm_loadu_si128((const __m128i*)(src + srcStride * 7));
+
+    const __m128i a0 = _mm_unpacklo_epi16(r0, r1);
+    const __m128i a1 = _mm_unpackhi_epi16(r0, r1);
+    const __m128i a2 = _mm_unpacklo_epi16(r2, r3);
+    const __m128i a3 = _mm_unpackhi_epi16(r2, r3);
+    const __m128i a4 = _mm_unpacklo_epi16(r4, r5);
+    const __m128i a5 = _mm_unpackhi_epi16(r4, r5);
+    const __m128i a6 = _mm_unpacklo_epi16(r6, r7);
+    const __m128i a7 = _mm_unpackhi_epi16(r6, r7);
+
+    const __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+    const __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+    const __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+    const __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+    const __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+    const __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+    const __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+    const __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+
+    _mm_storeu_si128((__m128i*)(dst), _mm_unpacklo_epi64(b0, b4));
+    _mm_storeu_si128((__m128i*)(dst + dstStride), _mm_unpackhi_epi64(b0, b4));
+    _mm_storeu_si128((__m128i*)(dst + dstStride * 2), _mm_unpacklo_epi64(b1, b5));
+    _mm_storeu_si128((__m128i*)(dst + dstStride * 3), _mm_unpackhi_epi64(b1, b5));
+    _mm_storeu_si128((__m128i*)(dst + dstStride * 4), _mm_unpacklo_epi64(b2, b6));
+    _mm_storeu_si128((__m128i*)(dst + dstStride * 5), _mm_unpackhi_epi64(b2, b6));
+    _mm_storeu_si128((__m128i*)(dst + dstStride * 6), _mm_unpacklo_epi64(b3, b7));
+    _mm_storeu_si128((__m128i*)(dst + dstStride * 7), _mm_unpackhi_epi64(b3, b7));
+  }
+
+  // 8x8 transpose of 8 bit values, every register holds two finished columns at the end
+  FORCEINLINE void Transpose8x8(const uint8* src, int64 srcStride, uint8* dst, int64 dstStride)
+  {
+    const __m128i r0 = _mm_loadl_epi64((const __m128i*)(src));
+    const __m128i r1 = _mm_loadl_epi64((const __m128i*)(src + srcStride));
+    const __m128i r2 = _mm_loadl_epi64((const __m128i*)(src + srcStride * 2));
+    const __m128i r3 = _mm_loadl_epi64((const __m128i*)(src + srcStride * 3));
+    const __m128i r4 = _mm_loadl_epi64((const __m128i*)(src + srcStride * 4));
+    const __m128i r5 = _mm_loadl_epi64((const __m128i*)(src + srcStride * 5));
+    const __m128i r6 = _mm_loadl_epi64((const __m128i*)(src + srcStride * 6));
+    const __m128i r7 = _mm_loadl_epi64((const __m128i*)(src + srcStride * 7));
+
+    const __m128i a0 = _mm_unpacklo_epi8(r0, r1);
+    const __m128i a1 = _mm_unpacklo_epi8(r2, r3);
+    const __m128i a2 = _mm_unpacklo_epi8(r4, r5);
+    const __m128i a3 = _mm_unpacklo_epi8(r6, r7);
+
+    const __m128i b0 = _mm_unpacklo_epi16(a0, a1);
+    const __m128i b1 = _mm_unpackhi_epi16(a0, a1);
+    const __m128i b2 = _mm_unpacklo_epi16(a2, a3);
+    const __m128i b3 = _mm_unpackhi_epi16(a2, a3);
+
+    const __m128i c0 = _mm_unpacklo_epi32(b0, b2);
+    const __m128i c1 = _mm_unpackhi_epi32(b0, b2);
+    const __m128i c2 = _mm_unpacklo_epi32(b1, b3);
+    const __m128i c3 = _mm_unpackhi_epi32(b1, b3);
+
+    _mm_storel_epi64((__m128i*)(dst), c0);
+    _mm_storel_epi64((__m128i*)(dst + dstStride), _mm_srli_si128(c0, 8));
+    _mm_storel_epi64((__m128i*)(dst + dstStride * 2), c1);
+    _mm_storel_epi64((__m128i*)(dst + dstStride * 3), _mm_srli_si128(c1, 8));
+    _mm_storel_epi64((__m128i*)(dst + dstStride * 4), c2);
+    _mm_storel_epi64((__m128i*)(dst + dstStride * 5), _mm_srli_si128(c2, 8));
+    _mm_storel_epi64((__m128i*)(dst + dstStride * 6), c3);
+    _mm_storel_epi64((__m128i*)(dst + dstStride * 7), _mm_srli_si128(c3, 8));
+  }
+#else
+  template<typename T>
+  FORCEINLINE void Transpose8x8(const T* src, int64 srcStride, T* dst, int64 dstStride)
+  {
+    for (int y = 0; y < SIMD_SIZE; y++)
+    {
+      for (int x = 0; x < SIMD_SIZE; x++)
+      {
+        dst[x * dstStride + y] = src[y * srcStride + x];
+      }
+    }
+  }
+#endif
+
+  template<typename T>
+  void TransposeBlock(const T* src, int64 srcStride, T* dst, int64 dstStride, int32 width, int32 height)
+  {
+    const int32 simdWidth = width - width % SIMD_SIZE;
+    const int32 simdHeight = height - height % SIMD_SIZE;
+    for (int32 y = 0; y < simdHeight; y += SIMD_SIZE)
+    {
+      for (int32 x = 0; x < simdWidth; x += SIMD_SIZE)
+      {
+        Transpose8x8(src + y * srcStride + x, srcStride, dst + x * dstStride + y, dstStride);
+      }
+    }
+
+    // borders that do not fill a whole register block
+    for (int32 y = 0; y < height; y++)
+    {
+      const int32 startX = y < simdHeight ? simdWidth : 0;
+      const T* srcRow = src + y * srcStride;
+      for (int32 x = startX; x < width; x++)
+      {
+        dst[x * dstStride + y] = srcRow[x];
+      }
+    }
+  }
+
+  template<typename T>
+  void Blit(const T* src, int64 srcStride, T* dst, int64 dstStride, int32 width, int32 height, EWCBlitOrientation orientation)
+  {
+    if (width <= 0 || height <= 0)
+      return;
+
+    // a y flip only changes the direction the source rows are walked
+    if (EnumHasAnyFlags(orientation, EWCBlitOrientation::FlipY))
+    {
+      src += (int64)(height - 1) * srcStride;
+      srcStride = -srcStride;
+    }
+
+    if (!EnumHasAnyFlags(orientation, EWCBlitOrientation::Transpose))
+    {
+      const bool bFlipX = EnumHasAnyFlags(orientation, EWCBlitOrientation::FlipX);
+      for (int32 y = 0; y < height; y++)
+      {
+        const T* srcRow = src + y * srcStride;
+        T* dstRow = dst + y * dstStride;
+        if (bFlipX)
+        {
+          for (int32 x = 0; x < width; x++)
+          {
+            dstRow[x] = srcRow[width - 1 - x];
+          }
+        }
+        else
+        {
+          FMemory::Memcpy(dstRow, srcRow, width * sizeof(T));
+        }
+      }
+      return;
+    }
+
+    // after the transpose source columns are destination rows, so an x flip walks the destination rows backwards
+    if (EnumHasAnyFlags(orientation, EWCBlitOrientation::FlipX))
+    {
+      dst += (int64)(width - 1) * dstStride;
+      dstStride = -dstStride;
+    }
+
+    for (int32 blockY = 0; blockY < height; blockY += FWCBlit::BLOCK_SIZE)
+    {
+      const int32 blockHeight = FMath::Min(FWCBlit::BLOCK_SIZE, height - blockY);
+      for (int32 blockX = 0; blockX < width; blockX += FWCBlit::BLOCK_SIZE)
+      {
+        const int32 blockWidth = FMath::Min(FWCBlit::BLOCK_SIZE, width - blockX);
+        TransposeBlock(src + blockY * srcStride + blockX, srcStride, dst + blockX * dstStride + blockY, dstStride, blockWidth, blockHeight);
+      }
+    }
+  }
+}
+
+void FWCBlit::Blit16(const uint16* src, int64 srcStride, uint16* dst, int64 dstStride, int32 width, int32 height, EWCBlitOrientation orientation)
+{
+  Blit(src, srcStride, dst, dstStride, width, height, orientation);
+}
+
+void FWCBlit::Blit8(const uint8* src, int64 srcStride, uint8* dst, int64 dstStride, int32 width, int32 height, EWCBlitOrientation orientation)
+{
+  Blit(src, srcStride, dst, dstStride, width, height, orientation);
+}
@@ -0,0 +1,82 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WCImportReport.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+void FWCImportReport::SetStats(const FWCSyncStats& stats)
+{
+  for (int i = 0; i < (int)EWCSyncStage::Num; i++)
+  {
+    stageSeconds[i] = stats.GetStageSeconds((EWCSyncStage)i);
+    stageBytes[i] = stats.GetStageBytes((EWCSyncStage)i);
+  }
+  bytesAssembled = stats.GetBytesAssembled();
+  bytesCopied = stats.GetBytesCopied();
+  peakBufferBytes = stats.GetPeakBufferBytes();
+}
+
+bool FWCImportReport::Save(const FString& filePath) const
+{
+  TSharedRef<FJsonObject> root = MakeShared<FJsonObject>();
+  root->SetNumberField(TEXT("Version"), FILE_VERSION);
+  root->SetStringField(TEXT("Timestamp"), timestamp.ToIso8601());
+  root->SetStringField(TEXT("PluginVersion"), pluginVersion);
+  root->SetStringField(TEXT("Map"), mapName);
+  root->SetStringField(TEXT("Terrain"), terrainName);
+  root->SetBoolField(TEXT("Completed"), bCompleted);
+  root->SetNumberField(TEXT("TotalSeconds"), totalSeconds);
+
+  TSharedRef<FJsonObject> manifestObject = MakeShared<FJsonObject>();
+  manifestObject->SetNumberField(TEXT("Version"), manifestVersion);
+  manifestObject->SetNumberField(TEXT("ResolutionX"), resolutionX);
+  manifestObject->SetNumberField(TEXT("ResolutionY"), resolutionY);
+  manifestObject->SetNumberField(TEXT("TilesX"), tilesX);
+  manifestObject->SetNumberField(TEXT("TilesY"), tilesY);
+  manifestObject->SetNumberField(TEXT("TileResolution"), tileResolution);
+  manifestObject->SetNumberField(TEXT("Layers"), numLayers);
+  root->SetObjectField(TEXT("Manifest"), manifestObject);
+
+  TSharedRef<FJsonObject> importObject = MakeShared<FJsonObject>();
+  importObject->SetNumberField(TEXT("UnrealTiles"), numUnrealTiles);
+  importObject->SetNumberField(TEXT("Imported"), numImported);
+  importObject->SetNumberField(TEXT("Updated"), numUpdated);
+  importObject->SetNumberField(TEXT("QuadsPerSection"), quadsPerSection);
+  importObject->SetBoolField(TEXT("ImportLayers"), bImportLayers);
+  importObject->SetBoolField(TEXT("StreamImport"), bStreamImport);
+  importObject->SetBoolField(TEXT("WorldPartition"), bUseWorldPartition);
+  importObject->SetBoolField(TEXT("IncrementalSync"), bIncrementalSync);
+  importObject->SetBoolField(TEXT("PackLayerTextures"), bPackLayerTextures);
+  importObject->SetBoolField(TEXT("LayerTextureArrays"), bLayerTextureArrays);
+  root->SetObjectField(TEXT("Import"), importObject);
+
+  // stages that run on several threads add up the time of all threads
+  TSharedRef<FJsonObject> stagesObject = MakeShared<FJsonObject>();
+  for (int i = 0; i < (int)EWCSyncStage::Num; i++)
+  {
+    TSharedRef<FJsonObject> stageObject = MakeShared<FJsonObject>();
+    stageObject->SetNumberField(TEXT("Seconds"), stageSeconds[i]);
+    stageObject->SetNumberField(TEXT("Bytes"), (double)stageBytes[i]);
+    stagesObject->SetObjectField(FWCSyncStats::GetStageName((EWCSyncStage)i), stageObject);
+  }
+  root->SetObjectField(TEXT("Stages"), stagesObject);
+
+  root->SetNumberField(TEXT("BytesRead"), (double)stageBytes[(int)EWCSyncStage::TileRead]);
+  root->SetNumberField(TEXT("BytesAssembled"), (double)bytesAssembled);
+  root->SetNumberField(TEXT("BytesCopied"), (double)bytesCopied);
+  root->SetNumberField(TEXT("PeakBufferBytes"), (double)peakBufferBytes);
+
+  FString jsonString;
+  TSharedRef<TJsonWriter<>> writer = TJsonWriterFactory<>::Create(&jsonString);
+  if (!FJsonSerializer::Serialize(root, writer))
+    return false;
+  return FFileHelper::SaveStringToFile(jsonString, *filePath);
+}
+
+FString FWCImportReport::GetFilePath(const FDateTime& timestamp)
+{
+  // milliseconds keep the reports of back to back syncs apart
+  return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("WorldCreatorBridge"), FString::Printf(TEXT("ImportReport_%s.json"), *timestamp.ToString(TEXT("%Y%m%d_%H%M%S_%s"))));
+}
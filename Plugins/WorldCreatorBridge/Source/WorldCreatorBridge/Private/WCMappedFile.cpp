@@ -0,0 +1,90 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WCMappedFile.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+FWCMappedFile::FWCMappedFile() = default;
+
+FWCMappedFile::FWCMappedFile(FWCMappedFile&& other)
+{
+  *this = MoveTemp(other);
+}
+
+FWCMappedFile& FWCMappedFile::operator=(FWCMappedFile&& other)
+{
+  if (this != &other)
+  {
+    Close();
+    handle = MoveTemp(other.handle);
+    region = MoveTemp(other.region);
+    // moving the array keeps its allocation, so data stays valid for the fallback path as well
+    ownedData = MoveTemp(other.ownedData);
+    data = other.data;
+    size = other.size;
+    viewOffset = other.viewOffset;
+    other.data = nullptr;
+    other.size = 0;
+    other.viewOffset = 0;
+  }
+  return *this;
+}
+
+FWCMappedFile::~FWCMappedFile()
+{
+  Close();
+}
+
+bool FWCMappedFile::Open(const FString& filePath)
+{
+  Close();
+
+  IPlatformFile& platformFile = FPlatformFileManager::Get().GetPlatformFile();
+  handle.Reset(platformFile.OpenMapped(*filePath));
+  if (handle.IsValid() && handle->GetFileSize() > 0)
+  {
+    region.Reset(handle->MapRegion(0, handle->GetFileSize(), true));
+    if (region.IsValid())
+    {
+      data = region->GetMappedPtr();
+      size = region->GetMappedSize();
+      return true;
+    }
+  }
+  region.Reset();
+  handle.Reset();
+
+  // mapping is not supported on every platform file (e.g. pak or network files)
+  if (!FFileHelper::LoadFileToArray(ownedData, *filePath, FILEREAD_Silent) || ownedData.Num() == 0)
+  {
+    ownedData.Empty();
+    return false;
+  }
+  data = ownedData.GetData();
+  size = ownedData.Num();
+  return true;
+}
+
+void FWCMappedFile::Close()
+{
+  region.Reset();
+  handle.Reset();
+  ownedData.Empty();
+  data = nullptr;
+  size = 0;
+  viewOffset = 0;
+}
+
+void FWCMappedFile::AdoptBuffer(TArray<uint8>&& buffer)
+{
+  Close();
+  ownedData = MoveTemp(buffer);
+  data = ownedData.GetData();
+  size = ownedData.Num();
+}
+
+void FWCMappedFile::SetViewOffset(int64 offset)
+{
+  viewOffset = FMath::Clamp<int64>(offset, 0, size);
+}
@@ -0,0 +1,286 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WCMaterialGraphBuilder.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpressionAdd.h"
+#include "Materials/MaterialExpressionAppendVector.h"
+#include "Materials/MaterialExpressionClamp.h"
+#include "Materials/MaterialExpressionComponentMask.h"
+#include "Materials/MaterialExpressionConstant.h"
+#include "Materials/MaterialExpressionConstant2Vector.h"
+#include "Materials/MaterialExpressionDDX.h"
+#include "Materials/MaterialExpressionDDY.h"
+#include "Materials/MaterialExpressionDivide.h"
+#include "Materials/MaterialExpressionFloor.h"
+#include "Materials/MaterialExpressionLandscapeLayerCoords.h"
+#include "Materials/MaterialExpressionMin.h"
+#include "Materials/MaterialExpressionMultiply.h"
+#include "Materials/MaterialExpressionOneMinus.h"
+#include "Materials/MaterialExpressionScalarParameter.h"
+#include "Materials/MaterialExpressionSubtract.h"
+#include "Materials/MaterialExpressionTextureSample.h"
+#include "Materials/MaterialExpressionTextureSampleParameter2D.h"
+#include "Materials/MaterialExpressionVectorParameter.h"
+
+namespace
+{
+  const float COLUMN_WIDTH = 250.0f;
+  const float ROW_HEIGHT = 150.0f;
+}
+
+FWCMaterialGraphBuilder::FWCMaterialGraphBuilder(UMaterial* inMaterial)
+  : material(inMaterial)
+{
+}
+
+template<typename T>
+T* FWCMaterialGraphBuilder::FindOrCreate(const FString& key, bool& bOutCreated)
+{
+  bOutCreated = false;
+  if (UMaterialExpression** expression = sharedExpressions.Find(key))
+    return CastChecked<T>(*expression);
+
+  T* expression = NewObject<T>(material);
+  AddExpression(expression);
+  sharedExpressions.Add(key, expression);
+  bOutCreated = true;
+  return expression;
+}
+
+template<typename T>
+UMaterialExpression* FWCMaterialGraphBuilder::Binary(const TCHAR* name, UMaterialExpression* a, UMaterialExpression* b, bool bCommutative)
+{
+  if (bCommutative && b < a)
+    Swap(a, b);
+
+  bool bCreated;
+  T* expression = FindOrCreate<T>(FString::Printf(TEXT("%s(%p,%p)"), name, a, b), bCreated);
+  if (bCreated)
+  {
+    expression->A.Expression = a;
+    expression->B.Expression = b;
+  }
+  return expression;
+}
+
+UObject* FWCMaterialGraphBuilder::GetOuter() const
+{
+  return material;
+}
+
+void FWCMaterialGraphBuilder::AddExpression(UMaterialExpression* expression)
+{
+  material->GetExpressionCollection().AddExpression(expression);
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::Constant(float value)
+{
+  bool bCreated;
+  UMaterialExpressionConstant* expression = FindOrCreate<UMaterialExpressionConstant>(FString::Printf(TEXT("Constant(%.9g)"), value), bCreated);
+  expression->R = value;
+  return expression;
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::Constant2(float r, float g)
+{
+  bool bCreated;
+  UMaterialExpressionConstant2Vector* expression = FindOrCreate<UMaterialExpressionConstant2Vector>(FString::Printf(TEXT("Constant2(%.9g,%.9g)"), r, g), bCreated);
+  expression->R = r;
+  expression->G = g;
+  return expression;
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::ScalarParameter(FName name, float defaultValue)
+{
+  bool bCreated;
+  UMaterialExpressionScalarParameter* expression = FindOrCreate<UMaterialExpressionScalarParameter>(FString::Printf(TEXT("ScalarParameter(%s)"), *name.ToString()), bCreated);
+  if (bCreated)
+  {
+    expression->ParameterName = name;
+    expression->DefaultValue = defaultValue;
+  }
+  return expression;
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::VectorParameter(FName name, const FLinearColor& defaultValue)
+{
+  bool bCreated;
+  UMaterialExpressionVectorParameter* expression = FindOrCreate<UMaterialExpressionVectorParameter>(FString::Printf(TEXT("VectorParameter(%s)"), *name.ToString()), bCreated);
+  if (bCreated)
+  {
+    expression->ParameterName = name;
+    expression->DefaultValue = defaultValue;
+  }
+  return expression;
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::LandscapeCoords()
+{
+  bool bCreated;
+  return FindOrCreate<UMaterialExpressionLandscapeLayerCoords>(TEXT("LandscapeCoords"), bCreated);
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::Add(UMaterialExpression* a, UMaterialExpression* b)
+{
+  return Binary<UMaterialExpressionAdd>(TEXT("Add"), a, b, true);
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::Subtract(UMaterialExpression* a, UMaterialExpression* b)
+{
+  return Binary<UMaterialExpressionSubtract>(TEXT("Subtract"), a, b, false);
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::Multiply(UMaterialExpression* a, UMaterialExpression* b)
+{
+  return Binary<UMaterialExpressionMultiply>(TEXT("Multiply"), a, b, true);
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::Divide(UMaterialExpression* a, UMaterialExpression* b)
+{
+  return Binary<UMaterialExpressionDivide>(TEXT("Divide"), a, b, false);
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::Min(UMaterialExpression* a, UMaterialExpression* b)
+{
+  return Binary<UMaterialExpressionMin>(TEXT("Min"), a, b, true);
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::Append(UMaterialExpression* a, UMaterialExpression* b)
+{
+  return Binary<UMaterialExpressionAppendVector>(TEXT("Append"), a, b, false);
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::Floor(UMaterialExpression* input)
+{
+  bool bCreated;
+  UMaterialExpressionFloor* expression = FindOrCreate<UMaterialExpressionFloor>(FString::Printf(TEXT("Floor(%p)"), input), bCreated);
+  expression->Input.Expression = input;
+  return expression;
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::OneMinus(UMaterialExpression* input)
+{
+  bool bCreated;
+  UMaterialExpressionOneMinus* expression = FindOrCreate<UMaterialExpressionOneMinus>(FString::Printf(TEXT("OneMinus(%p)"), input), bCreated);
+  expression->Input.Expression = input;
+  return expression;
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::Clamp(UMaterialExpression* input)
+{
+  bool bCreated;
+  UMaterialExpressionClamp* expression = FindOrCreate<UMaterialExpressionClamp>(FString::Printf(TEXT("Clamp(%p)"), input), bCreated);
+  expression->Input.Expression = input;
+  return expression;
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::Mask(UMaterialExpression* input, bool r, bool g, bool b, bool a)
+{
+  bool bCreated;
+  UMaterialExpressionComponentMask* expression = FindOrCreate<UMaterialExpressionComponentMask>(FString::Printf(TEXT("Mask(%p,%d%d%d%d)"), input, r, g, b, a), bCreated);
+  expression->Input.Expression = input;
+  expression->R = r;
+  expression->G = g;
+  expression->B = b;
+  expression->A = a;
+  return expression;
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::DDX(UMaterialExpression* input)
+{
+  bool bCreated;
+  UMaterialExpressionDDX* expression = FindOrCreate<UMaterialExpressionDDX>(FString::Printf(TEXT("DDX(%p)"), input), bCreated);
+  expression->Value.Expression = input;
+  return expression;
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::DDY(UMaterialExpression* input)
+{
+  bool bCreated;
+  UMaterialExpressionDDY* expression = FindOrCreate<UMaterialExpressionDDY>(FString::Printf(TEXT("DDY(%p)"), input), bCreated);
+  expression->Value.Expression = input;
+  return expression;
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::TextureSample(UTexture* texture, UMaterialExpression* coordinates, EMaterialSamplerType samplerType)
+{
+  bool bCreated;
+  UMaterialExpressionTextureSample* expression = FindOrCreate<UMaterialExpressionTextureSample>(FString::Printf(TEXT("TextureSample(%p,%p,%d)"), texture, coordinates, (int)samplerType), bCreated);
+  expression->Texture = texture;
+  expression->Coordinates.Expression = coordinates;
+  expression->SamplerType = samplerType;
+  return expression;
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::TextureSampleGrad(UTexture* texture, UMaterialExpression* coordinates, UMaterialExpression* coordinatesDX, UMaterialExpression* coordinatesDY, EMaterialSamplerType samplerType)
+{
+  bool bCreated;
+  UMaterialExpressionTextureSample* expression = FindOrCreate<UMaterialExpressionTextureSample>(
+    FString::Printf(TEXT("TextureSampleGrad(%p,%p,%p,%p,%d)"), texture, coordinates, coordinatesDX, coordinatesDY, (int)samplerType), bCreated);
+  expression->Texture = texture;
+  expression->Coordinates.Expression = coordinates;
+  expression->MipValueMode = TMVM_Derivative;
+  expression->CoordinatesDX.Expression = coordinatesDX;
+  expression->CoordinatesDY.Expression = coordinatesDY;
+  expression->SamplerType = samplerType;
+  return expression;
+}
+
+UMaterialExpression* FWCMaterialGraphBuilder::TextureSampleParameter(FName name, UTexture* texture, UMaterialExpression* coordinates, EMaterialSamplerType samplerType)
+{
+  bool bCreated;
+  UMaterialExpressionTextureSampleParameter2D* expression = FindOrCreate<UMaterialExpressionTextureSampleParameter2D>(FString::Printf(TEXT("TextureSampleParameter(%s)"), *name.ToString()), bCreated);
+  if (bCreated)
+  {
+    expression->ParameterName = name;
+    expression->Texture = texture;
+    expression->Coordinates.Expression = coordinates;
+    expression->SamplerType = samplerType;
+  }
+  return expression;
+}
+
+void FWCMaterialGraphBuilder::Finish(const TArray<UMaterialExpression*>& outputs)
+{
+  // column of every used expression, the longest path to an output decides it
+  TMap<UMaterialExpression*, int> columns;
+  TArray<TPair<UMaterialExpression*, int>> stack;
+  for (UMaterialExpression* output : outputs)
+  {
+    if (output != nullptr)
+      stack.Emplace(output, 0);
+  }
+  while (stack.Num() > 0)
+  {
+    const TPair<UMaterialExpression*, int> entry = stack.Pop(EAllowShrinking::No);
+    const int* column = columns.Find(entry.Key);
+    if (column != nullptr && *column >= entry.Value)
+      continue;
+
+    columns.Add(entry.Key, entry.Value);
+    for (int32 i = 0; const FExpressionInput* input = entry.Key->GetInput(i); i++)
+    {
+      if (input->Expression != nullptr)
+        stack.Emplace(input->Expression, entry.Value + 1);
+    }
+  }
+
+  FMaterialExpressionCollection& collection = material->GetExpressionCollection();
+  const TArray<TObjectPtr<UMaterialExpression>> expressions = collection.Expressions;
+  for (UMaterialExpression* expression : expressions)
+  {
+    if (!columns.Contains(expression))
+      collection.RemoveExpression(expression);
+  }
+
+  TMap<int, int> rows;
+  for (UMaterialExpression* expression : collection.Expressions)
+  {
+    const int column = columns.FindChecked(expression);
+    int& row = rows.FindOrAdd(column);
+    expression->MaterialExpressionEditorX = -(column + 1) * COLUMN_WIDTH;
+    expression->MaterialExpressionEditorY = row * ROW_HEIGHT;
+    row++;
+  }
+  sharedExpressions.Empty();
+}
@@ -0,0 +1,167 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WCSplatKernels.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+#define WC_SPLAT_KERNEL_SSE2 1
+#include <emmintrin.h>
+#if defined(PLATFORM_ALWAYS_HAS_AVX_2) && PLATFORM_ALWAYS_HAS_AVX_2
+#define WC_SPLAT_KERNEL_AVX2 1
+#include <immintrin.h>
+#endif
+#elif PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#define WC_SPLAT_KERNEL_NEON 1
+#include <arm_neon.h>
+#endif
+
+#ifndef WC_SPLAT_KERNEL_SSE2
+#define WC_SPLAT_KERNEL_SSE2 0
+#endif
+#ifndef WC_SPLAT_KERNEL_AVX2
+#define WC_SPLAT_KERNEL_AVX2 0
+#endif
+#ifndef WC_SPLAT_KERNEL_NEON
+#define WC_SPLAT_KERNEL_NEON 0
+#endif
+
+namespace
+{
+#if WC_SPLAT_KERNEL_AVX2
+  // 32 pixels, the lane wise packs are put back into pixel order by the final permute
+  template<int Shift>
+  FORCEINLINE __m256i ExtractChannelAVX2(__m256i v0, __m256i v1, __m256i v2, __m256i v3, __m256i mask, __m256i order)
+  {
+    const __m256i c0 = _mm256_and_si256(_mm256_srli_epi32(v0, Shift), mask);
+    const __m256i c1 = _mm256_and_si256(_mm256_srli_epi32(v1, Shift), mask);
+    const __m256i c2 = _mm256_and_si256(_mm256_srli_epi32(v2, Shift), mask);
+    const __m256i c3 = _mm256_and_si256(_mm256_srli_epi32(v3, Shift), mask);
+    const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(c0, c1), _mm256_packs_epi32(c2, c3));
+    return _mm256_permutevar8x32_epi32(packed, order);
+  }
+#endif
+
+#if WC_SPLAT_KERNEL_SSE2
+  // 16 pixels, every channel is shifted into the low byte of its pixel and narrowed 32 -> 16 -> 8 bit
+  template<int Shift>
+  FORCEINLINE __m128i ExtractChannelSSE2(__m128i v0, __m128i v1, __m128i v2, __m128i v3, __m128i mask)
+  {
+    const __m128i c0 = _mm_and_si128(_mm_srli_epi32(v0, Shift), mask);
+    const __m128i c1 = _mm_and_si128(_mm_srli_epi32(v1, Shift), mask);
+    const __m128i c2 = _mm_and_si128(_mm_srli_epi32(v2, Shift), mask);
+    const __m128i c3 = _mm_and_si128(_mm_srli_epi32(v3, Shift), mask);
+    return _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+  }
+#endif
+}
+
+void FWCSplatKernels::Deinterleave(const uint8* src, int32 count, int bytesPerPixel, int numChannels, uint8* const* planes)
+{
+  numChannels = FMath::Clamp(numChannels, 0, MAX_CHANNELS);
+  if (bytesPerPixel == 4)
+  {
+    uint8* usedPlanes[MAX_CHANNELS] = { nullptr, nullptr, nullptr, nullptr };
+    for (int c = 0; c < numChannels; c++)
+    {
+      usedPlanes[c] = planes[c];
+    }
+    DeinterleaveBGRA(src, count, usedPlanes);
+  }
+  else
+  {
+    DeinterleaveScalar(src, count, bytesPerPixel, numChannels, planes);
+  }
+}
+
+void FWCSplatKernels::DeinterleaveBGRA(const uint8* src, int32 count, uint8* const* planes)
+{
+  uint8* r = planes[0];
+  uint8* g = planes[1];
+  uint8* b = planes[2];
+  uint8* a = planes[3];
+  int32 i = 0;
+
+#if WC_SPLAT_KERNEL_AVX2
+  {
+    const __m256i mask = _mm256_set1_epi32(0xff);
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (; i + 32 <= count; i += 32)
+    {
+      const __m256i* in = (const __m256i*)(src + i * 4);
+      const __m256i v0 = _mm256_loadu_si256(in);
+      const __m256i v1 = _mm256_loadu_si256(in + 1);
+      const __m256i v2 = _mm256_loadu_si256(in + 2);
+      const __m256i v3 = _mm256_loadu_si256(in + 3);
+      if (r) _mm256_storeu_si256((__m256i*)(r + i), ExtractChannelAVX2<16>(v0, v1, v2, v3, mask, order));
+      if (g) _mm256_storeu_si256((__m256i*)(g + i), ExtractChannelAVX2<8>(v0, v1, v2, v3, mask, order));
+      if (b) _mm256_storeu_si256((__m256i*)(b + i), ExtractChannelAVX2<0>(v0, v1, v2, v3, mask, order));
+      if (a) _mm256_storeu_si256((__m256i*)(a + i), ExtractChannelAVX2<24>(v0, v1, v2, v3, mask, order));
+    }
+  }
+#endif
+
+#if WC_SPLAT_KERNEL_SSE2
+  {
+    const __m128i mask = _mm_set1_epi32(0xff);
+    for (; i + 16 <= count; i += 16)
+    {
+      const __m128i* in = (const __m128i*)(src + i * 4);
+      const __m128i v0 = _mm_loadu_si128(in);
+      const __m128i v1 = _mm_loadu_si128(in + 1);
+      const __m128i v2 = _mm_loadu_si128(in + 2);
+      const __m128i v3 = _mm_loadu_si128(in + 3);
+      if (r) _mm_storeu_si128((__m128i*)(r + i), ExtractChannelSSE2<16>(v0, v1, v2, v3, mask));
+      if (g) _mm_storeu_si128((__m128i*)(g + i), ExtractChannelSSE2<8>(v0, v1, v2, v3, mask));
+      if (b) _mm_storeu_si128((__m128i*)(b + i), ExtractChannelSSE2<0>(v0, v1, v2, v3, mask));
+      if (a) _mm_storeu_si128((__m128i*)(a + i), ExtractChannelSSE2<24>(v0, v1, v2, v3, mask));
+    }
+  }
+#endif
+
+#if WC_SPLAT_KERNEL_NEON
+  for (; i + 16 <= count; i += 16)
+  {
+    // vld4 already splits the pixels into B, G, R and A registers
+    const uint8x16x4_t pixels = vld4q_u8(src + i * 4);
+    if (r) vst1q_u8(r + i, pixels.val[2]);
+    if (g) vst1q_u8(g + i, pixels.val[1]);
+    if (b) vst1q_u8(b + i, pixels.val[0]);
+    if (a) vst1q_u8(a + i, pixels.val[3]);
+  }
+#endif
+
+  if (i < count)
+  {
+    uint8* remainingPlanes[MAX_CHANNELS] =
+    {
+      r ? r + i : nullptr,
+      g ? g + i : nullptr,
+      b ? b + i : nullptr,
+      a ? a + i : nullptr
+    };
+    DeinterleaveScalar(src + i * 4, count - i, 4, MAX_CHANNELS, remainingPlanes);
+  }
+}
+
+void FWCSplatKernels::DeinterleaveScalar(const uint8* src, int32 count, int bytesPerPixel, int numChannels, uint8* const* planes)
+{
+  for (int c = 0; c < numChannels; c++)
+  {
+    uint8* plane = planes[c];
+    if (plane == nullptr)
+      continue;
+
+    // grayscale files only carry their channels in order
+    const int offset = bytesPerPixel >= 3 ? GetChannelByteOffset(c) : c;
+    if (offset >= bytesPerPixel)
+    {
+      FMemory::Memzero(plane, count);
+      continue;
+    }
+
+    const uint8* in = src + offset;
+    for (int32 i = 0; i < count; i++)
+    {
+      plane[i] = in[i * bytesPerPixel];
+    }
+  }
+}
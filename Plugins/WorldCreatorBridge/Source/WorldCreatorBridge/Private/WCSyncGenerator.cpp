@@ -0,0 +1,187 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WCSyncGenerator.h"
+#include "WCTgaReader.h"
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+  const int BYTES_PER_SPLAT_PIXEL = 4;
+
+  // normalized height of the terrain position, rolling hills plus noise
+  float GetHeight(int x, int y, FRandomStream& random)
+  {
+    const float hills = FMath::Sin(x * 0.0031f) * FMath::Cos(y * 0.0027f) * 0.3f + FMath::Sin((x + y) * 0.0113f) * 0.1f;
+    return FMath::Clamp(0.5f + hills + random.FRandRange(-0.005f, 0.005f), 0.0f, 1.0f);
+  }
+
+  // weight of a layer at the terrain position, the weights of all layers add up to 255
+  void GetLayerWeights(int x, int y, int numLayers, FRandomStream& random, uint8* outWeights)
+  {
+    float weights[64];
+    float sum = 0.0f;
+    for (int i = 0; i < numLayers; i++)
+    {
+      weights[i] = FMath::Max(0.0f, FMath::Sin(x * 0.004f * (i + 1) + i) * FMath::Cos(y * 0.003f * (i + 2)) + random.FRandRange(0.0f, 0.1f));
+      sum += weights[i];
+    }
+    for (int i = 0; i < numLayers; i++)
+    {
+      outWeights[i] = sum > 0.0f ? (uint8)(weights[i] / sum * 255.0f) : (i == 0 ? 255 : 0);
+    }
+  }
+
+  void WriteUInt16(uint8* dest, uint16 value)
+  {
+    dest[0] = value & 0xFF;
+    dest[1] = value >> 8;
+  }
+}
+
+FString FWCSyncGenerator::Generate(const FWCSyncGeneratorSettings& settings)
+{
+  // version 3 reads the size of a tile from its splatmaps, it needs at least one
+  const int numLayers = FMath::Clamp(settings.numLayers, settings.version >= 3 ? 1 : 0, 64);
+  const int numSplatmaps = FMath::DivideAndRoundUp(numLayers, 4);
+  const int resolutionX = settings.tileResolution * settings.tilesX;
+  const int resolutionY = settings.tileResolution * settings.tilesY;
+  if (settings.directory.Len() <= 0 || settings.tileResolution <= 0 || resolutionX > MAX_uint16 || resolutionY > MAX_uint16)
+    return FString();
+
+  IFileManager::Get().MakeDirectory(*settings.directory, true);
+  FWCSyncGeneratorSettings layerSettings = settings;
+  layerSettings.numLayers = numLayers;
+
+  if (settings.version >= 3)
+  {
+    for (int tileY = 0; tileY < settings.tilesY; tileY++)
+    {
+      for (int tileX = 0; tileX < settings.tilesX; tileX++)
+      {
+        const int x0 = tileX * settings.tileResolution;
+        const int y0 = tileY * settings.tileResolution;
+        const int32 tileSeed = settings.seed + tileY * settings.tilesX + tileX;
+        const FString heightmapPath = FString::Printf(TEXT("%s/heightmap_%d_%d.raw"), *settings.directory, tileX, tileY);
+        if (!WriteHeightmap(heightmapPath, x0, y0, settings.tileResolution, settings.tileResolution, true, tileSeed))
+          return FString();
+
+        for (int i = 0; i < numSplatmaps; i++)
+        {
+          const FString splatmapPath = FString::Printf(TEXT("%s/splatmap_%d_%d_%d.tga"), *settings.directory, i, tileX, tileY);
+          if (!WriteSplatmap(splatmapPath, x0, y0, settings.tileResolution, settings.tileResolution, i * 4, numLayers, FMath::Min(4, numLayers - i * 4), tileSeed))
+            return FString();
+        }
+      }
+    }
+  }
+  else
+  {
+    if (!WriteHeightmap(settings.directory / TEXT("heightmap.raw"), 0, 0, resolutionX, resolutionY, false, settings.seed))
+      return FString();
+    for (int i = 0; i < numSplatmaps; i++)
+    {
+      const FString splatmapPath = FString::Printf(TEXT("%s/splatmap_%d.tga"), *settings.directory, i);
+      if (!WriteSplatmap(splatmapPath, 0, 0, resolutionX, resolutionY, i * 4, numLayers, FMath::Min(4, numLayers - i * 4), settings.seed))
+        return FString();
+    }
+  }
+
+  const FString manifestPath = settings.directory / TEXT("Bridge.xml");
+  if (!FFileHelper::SaveStringToFile(BuildManifest(layerSettings, resolutionX, resolutionY), *manifestPath))
+    return FString();
+  return manifestPath;
+}
+
+int64 FWCSyncGenerator::GetDataSize(const FWCSyncGeneratorSettings& settings)
+{
+  const int numLayers = FMath::Clamp(settings.numLayers, settings.version >= 3 ? 1 : 0, 64);
+  const int64 numPixels = (int64)settings.tileResolution * settings.tileResolution * settings.tilesX * settings.tilesY;
+  const int64 numSplatmaps = FMath::DivideAndRoundUp(numLayers, 4);
+  const int64 numFiles = settings.version >= 3 ? (int64)settings.tilesX * settings.tilesY : 1;
+  return numPixels * (sizeof(uint16) + numSplatmaps * BYTES_PER_SPLAT_PIXEL) + numFiles * numSplatmaps * FWCTgaHeader::SIZE;
+}
+
+bool FWCSyncGenerator::WriteHeightmap(const FString& filePath, int x0, int y0, int width, int length, bool bBottomUp, int32 seed)
+{
+  // 16 bit little endian, rows of version 3 tiles are stored bottom up
+  FRandomStream random(seed);
+  TArray<uint8> data;
+  data.SetNumUninitialized((int64)width * length * sizeof(uint16));
+  for (int row = 0; row < length; row++)
+  {
+    const int y = y0 + (bBottomUp ? length - 1 - row : row);
+    uint8* dest = data.GetData() + (int64)row * width * sizeof(uint16);
+    for (int x = 0; x < width; x++)
+    {
+      WriteUInt16(dest + x * sizeof(uint16), (uint16)(GetHeight(x0 + x, y, random) * MAX_uint16));
+    }
+  }
+  return FFileHelper::SaveArrayToFile(data, *filePath);
+}
+
+bool FWCSyncGenerator::WriteSplatmap(const FString& filePath, int x0, int y0, int width, int length, int firstLayer, int numLayers, int numChannels, int32 seed)
+{
+  // uncompressed 32 bit BGRA with bottom-left origin, the layout the tile assembly reads in place
+  FRandomStream random(seed);
+  TArray<uint8> data;
+  data.SetNumZeroed(FWCTgaHeader::SIZE + (int64)width * length * BYTES_PER_SPLAT_PIXEL);
+  uint8* header = data.GetData();
+  header[2] = 2;
+  WriteUInt16(header + 12, width);
+  WriteUInt16(header + 14, length);
+  header[16] = BYTES_PER_SPLAT_PIXEL * 8;
+  header[17] = 8;
+
+  // channels are stored in BGRA order, layer k of the splatmap is channel k of the decoded pixel
+  const int channelOrder[4] = { 2, 1, 0, 3 };
+  uint8 weights[64];
+  for (int row = 0; row < length; row++)
+  {
+    uint8* dest = data.GetData() + FWCTgaHeader::SIZE + (int64)row * width * BYTES_PER_SPLAT_PIXEL;
+    for (int x = 0; x < width; x++)
+    {
+      GetLayerWeights(x0 + x, y0 + length - 1 - row, numLayers, random, weights);
+      for (int k = 0; k < numChannels; k++)
+      {
+        dest[x * BYTES_PER_SPLAT_PIXEL + channelOrder[k]] = weights[firstLayer + k];
+      }
+    }
+  }
+  return FFileHelper::SaveArrayToFile(data, *filePath);
+}
+
+FString FWCSyncGenerator::BuildManifest(const FWCSyncGeneratorSettings& settings, int resolutionX, int resolutionY)
+{
+  // one unit per pixel, the height range matches the default World Creator terrain
+  FString xml = FString::Printf(TEXT("<WorldCreator Version=\"%s\">\n"), settings.version >= 3 ? TEXT("4.0") : TEXT("2.0"));
+  xml += FString::Printf(TEXT("  <Surface MinHeight=\"0\" MaxHeight=\"1000\" Height=\"1000\" Width=\"%d\" Length=\"%d\" ResolutionX=\"%d\" ResolutionY=\"%d\""),
+    resolutionX, resolutionY, resolutionX, resolutionY);
+  if (settings.version >= 3)
+  {
+    xml += FString::Printf(TEXT(" TilesX=\"%d\" TilesY=\"%d\" TileResolution=\"%d\" />\n"), settings.tilesX, settings.tilesY, settings.tileResolution);
+  }
+  else
+  {
+    xml += TEXT(" HeightCenter=\"0\" />\n");
+  }
+
+  if (settings.numLayers > 0)
+  {
+    xml += TEXT("  <Texturing>\n");
+    for (int i = 0; i * 4 < settings.numLayers; i++)
+    {
+      xml += FString::Printf(TEXT("    <Splatmap Index=\"%d\" Name=\"splatmap_%d.tga\">\n"), i, i);
+      for (int layer = i * 4; layer < FMath::Min(settings.numLayers, i * 4 + 4); layer++)
+      {
+        const FColor color = FLinearColor::MakeFromHSV8((uint8)(layer * 37), 160, 200).ToFColor(true);
+        xml += FString::Printf(TEXT("      <Layer Name=\"Layer%d\" Color=\"#ff%02x%02x%02x\" TileSize=\"10,10\" TileOffset=\"0,0\" />\n"), layer, color.R, color.G, color.B);
+      }
+      xml += TEXT("    </Splatmap>\n");
+    }
+    xml += TEXT("  </Texturing>\n");
+  }
+  xml += TEXT("</WorldCreator>\n");
+  return xml;
+}
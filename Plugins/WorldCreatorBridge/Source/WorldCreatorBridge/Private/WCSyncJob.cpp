@@ -0,0 +1,159 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WCSyncJob.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+#define LOCTEXT_NAMESPACE "FWCSyncJob"
+
+FWCSyncJob::FWCSyncJob(const FText& title)
+  : title(title)
+{
+}
+
+FWCSyncJob::~FWCSyncJob()
+{
+  if (tickerHandle.IsValid())
+  {
+    FTSTicker::GetCoreTicker().RemoveTicker(tickerHandle);
+  }
+}
+
+void FWCSyncJob::AddStage(const FText& name, int numSteps, FStepFunction stepFunction)
+{
+  if (numSteps <= 0)
+    return;
+  FStage* stage = new FStage();
+  stage->name = name;
+  stage->numSteps = numSteps;
+  stage->stepFunction = MoveTemp(stepFunction);
+  stages.Add(stage);
+}
+
+void FWCSyncJob::Start(FFinishFunction finishFunction)
+{
+  finish = MoveTemp(finishFunction);
+
+  FNotificationInfo info(title);
+  info.bFireAndForget = false;
+  info.bUseThrobber = true;
+  info.ExpireDuration = 3.0f;
+  info.ButtonDetails.Add(FNotificationButtonInfo(LOCTEXT("Cancel", "Cancel"), LOCTEXT("CancelTooltip", "Stop the sync after the current landscape"),
+    FSimpleDelegate::CreateSP(this, &FWCSyncJob::Cancel), SNotificationItem::CS_Pending));
+  notification = FSlateNotificationManager::Get().AddNotification(info);
+  if (notification.IsValid())
+  {
+    notification->SetCompletionState(SNotificationItem::CS_Pending);
+  }
+  UpdateNotification();
+
+  tickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FWCSyncJob::Tick));
+}
+
+bool FWCSyncJob::Run(FFinishFunction finishFunction)
+{
+  finish = MoveTemp(finishFunction);
+  TSharedRef<FWCSyncJob> self = AsShared();
+
+  for (; stageIndex < stages.Num() && !bCancelled; stageIndex++)
+  {
+    FStage& stage = stages[stageIndex];
+    UE_LOG(LogTemp, Display, TEXT("%s: %s (%d)"), *title.ToString(), *stage.name.ToString(), stage.numSteps);
+    for (stepIndex = 0; stepIndex < stage.numSteps; stepIndex++)
+    {
+      if (!stage.stepFunction(stepIndex))
+      {
+        bCancelled = true;
+        break;
+      }
+    }
+  }
+
+  Finish(!bCancelled);
+  return !bCancelled;
+}
+
+void FWCSyncJob::Cancel()
+{
+  bCancelled = true;
+}
+
+void FWCSyncJob::Stop()
+{
+  if (!IsRunning())
+    return;
+
+  TSharedRef<FWCSyncJob> self = AsShared();
+  FTSTicker::GetCoreTicker().RemoveTicker(tickerHandle);
+  bCancelled = true;
+  Finish(false);
+}
+
+bool FWCSyncJob::Tick(float deltaTime)
+{
+  // keep the job alive until the end of the tick, the finish function may release the last reference
+  TSharedRef<FWCSyncJob> self = AsShared();
+
+  const double startTime = FPlatformTime::Seconds();
+  do
+  {
+    if (bCancelled)
+    {
+      Finish(false);
+      return false;
+    }
+    if (stageIndex >= stages.Num())
+    {
+      Finish(true);
+      return false;
+    }
+
+    FStage& stage = stages[stageIndex];
+    if (!stage.stepFunction(stepIndex))
+    {
+      bCancelled = true;
+      Finish(false);
+      return false;
+    }
+    if (++stepIndex >= stage.numSteps)
+    {
+      stageIndex++;
+      stepIndex = 0;
+    }
+  } while (FPlatformTime::Seconds() - startTime < FRAME_BUDGET_SECONDS);
+
+  UpdateNotification();
+  return true;
+}
+
+void FWCSyncJob::Finish(bool bCompleted)
+{
+  // the ticker removes the delegate itself when Tick returns false
+  tickerHandle.Reset();
+  if (notification.IsValid())
+  {
+    notification->SetText(bCompleted ? FText::Format(LOCTEXT("Completed", "{0} finished"), title) : FText::Format(LOCTEXT("Cancelled", "{0} cancelled"), title));
+    notification->SetSubText(FText::GetEmpty());
+    notification->SetCompletionState(bCompleted ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+    notification->ExpireAndFadeout();
+    notification.Reset();
+  }
+
+  if (finish)
+  {
+    FFinishFunction finishFunction = MoveTemp(finish);
+    finishFunction(bCompleted);
+  }
+}
+
+void FWCSyncJob::UpdateNotification()
+{
+  if (!notification.IsValid() || stageIndex >= stages.Num())
+    return;
+
+  const FStage& stage = stages[stageIndex];
+  notification->SetText(FText::Format(LOCTEXT("Progress", "{0}: {1}"), title, stage.name));
+  notification->SetSubText(FText::Format(LOCTEXT("Step", "{0} / {1}"), FText::AsNumber(stepIndex + 1), FText::AsNumber(stage.numSteps)));
+}
+
+#undef LOCTEXT_NAMESPACE
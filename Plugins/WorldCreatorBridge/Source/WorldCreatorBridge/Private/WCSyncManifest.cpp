@@ -0,0 +1,142 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WCSyncManifest.h"
+#include "XmlHelper.h"
+#include "Hash/xxhash.h"
+
+namespace
+{
+  template<typename T>
+  void HashValue(FXxHash64Builder& builder, const T& value)
+  {
+    builder.Update(&value, sizeof(T));
+  }
+
+  void HashValue(FXxHash64Builder& builder, const FString& value)
+  {
+    // the length keeps neighbouring strings apart
+    HashValue(builder, value.Len());
+    builder.Update(*value, value.Len() * sizeof(TCHAR));
+  }
+
+  void HashSplatmaps(FXxHash64Builder& builder, const TArray<FWCManifestSplatmap>& splatmaps)
+  {
+    for (const FWCManifestSplatmap& splatmap : splatmaps)
+    {
+      HashValue(builder, splatmap.index);
+      HashValue(builder, splatmap.name);
+      HashValue(builder, splatmap.layers.Num());
+      for (const FWCManifestLayer& layer : splatmap.layers)
+      {
+        HashValue(builder, layer.name);
+        HashValue(builder, layer.color);
+        HashValue(builder, layer.tileSize);
+        HashValue(builder, layer.tileOffset);
+        HashValue(builder, layer.albedoFile);
+        HashValue(builder, layer.normalFile);
+        HashValue(builder, layer.aoFile);
+        HashValue(builder, layer.displacementFile);
+        HashValue(builder, layer.roughnessFile);
+      }
+    }
+  }
+}
+
+int FWCSyncManifest::GetNumLayers() const
+{
+  int numLayers = 0;
+  for (const FWCManifestSplatmap& splatmap : splatmaps)
+  {
+    numLayers += splatmap.layers.Num();
+  }
+  return numLayers;
+}
+
+uint64 FWCSyncManifest::GetHash() const
+{
+  FXxHash64Builder builder;
+  HashValue(builder, version);
+  HashValue(builder, minHeight);
+  HashValue(builder, maxHeight);
+  HashValue(builder, height);
+  HashValue(builder, width);
+  HashValue(builder, length);
+  HashValue(builder, resolutionX);
+  HashValue(builder, resolutionY);
+  HashValue(builder, tilesX);
+  HashValue(builder, tilesY);
+  HashValue(builder, tileResolution);
+  HashValue(builder, heightCenter);
+  HashValue(builder, bHasTexturing);
+  HashSplatmaps(builder, splatmaps);
+  return builder.Finalize().Hash;
+}
+
+uint64 FWCSyncManifest::GetLayerHash() const
+{
+  FXxHash64Builder builder;
+  HashValue(builder, bHasTexturing);
+  HashSplatmaps(builder, splatmaps);
+  return builder.Finalize().Hash;
+}
+
+TSharedPtr<const FWCSyncManifest> FWCSyncManifest::Load(const FString& filePath)
+{
+  FXmlFile configFile(filePath);
+  const FXmlNode* root = configFile.GetRootNode();
+  if (root == nullptr)
+    return nullptr;
+  const FXmlNode* surfaceNode = root->FindChildNode(TEXT("Surface"));
+  if (surfaceNode == nullptr)
+    return nullptr;
+
+  TSharedPtr<FWCSyncManifest> manifest = MakeShared<FWCSyncManifest>();
+  manifest->version = XmlHelper::GetFloat(root, TEXT("Version"));
+
+  manifest->minHeight = XmlHelper::GetFloat(surfaceNode, TEXT("MinHeight"));
+  manifest->maxHeight = XmlHelper::GetFloat(surfaceNode, TEXT("MaxHeight"));
+  manifest->height = XmlHelper::GetFloat(surfaceNode, TEXT("Height"));
+  manifest->width = XmlHelper::GetInt(surfaceNode, TEXT("Width"));
+  manifest->length = XmlHelper::GetInt(surfaceNode, TEXT("Length"));
+  manifest->resolutionX = XmlHelper::GetInt(surfaceNode, TEXT("ResolutionX"));
+  manifest->resolutionY = XmlHelper::GetInt(surfaceNode, TEXT("ResolutionY"));
+  manifest->tilesX = XmlHelper::GetInt(surfaceNode, TEXT("TilesX"));
+  manifest->tilesY = XmlHelper::GetInt(surfaceNode, TEXT("TilesY"));
+  manifest->tileResolution = XmlHelper::GetInt(surfaceNode, TEXT("TileResolution"));
+  manifest->heightCenter = XmlHelper::GetInt(surfaceNode, TEXT("HeightCenter"));
+
+  const FXmlNode* texturingNode = root->FindChildNode(TEXT("Texturing"));
+  manifest->bHasTexturing = texturingNode != nullptr;
+  if (texturingNode != nullptr)
+  {
+    for (const FXmlNode* splatmapNode : texturingNode->GetChildrenNodes())
+    {
+      FWCManifestSplatmap& splatmap = manifest->splatmaps.AddDefaulted_GetRef();
+      splatmap.index = XmlHelper::GetInt(splatmapNode, TEXT("Index"));
+      splatmap.name = XmlHelper::GetString(splatmapNode, TEXT("Name"));
+      for (const FXmlNode* layerNode : splatmapNode->GetChildrenNodes())
+      {
+        ReadLayer(layerNode, splatmap.layers.AddDefaulted_GetRef());
+      }
+    }
+  }
+  return manifest;
+}
+
+void FWCSyncManifest::ReadLayer(const FXmlNode* node, FWCManifestLayer& outLayer)
+{
+  outLayer.name = XmlHelper::GetString(node, TEXT("Name"));
+
+  // colors are stored as #ffRRGGBB
+  FString colorAtt = XmlHelper::GetString(node, TEXT("Color"));
+  colorAtt.RemoveFromStart(TEXT("#ff"));
+  outLayer.color = FLinearColor(FColor::FromHex(colorAtt));
+
+  XmlHelper::GetFloat2(node, TEXT("TileSize"), &outLayer.tileSize.X, &outLayer.tileSize.Y);
+  XmlHelper::GetFloat2(node, TEXT("TileOffset"), &outLayer.tileOffset.X, &outLayer.tileOffset.Y);
+  outLayer.albedoFile = XmlHelper::GetString(node, TEXT("AlbedoFile"));
+  outLayer.normalFile = XmlHelper::GetString(node, TEXT("NormalFile"));
+  outLayer.aoFile = XmlHelper::GetString(node, TEXT("AoFile"));
+  outLayer.displacementFile = XmlHelper::GetString(node, TEXT("DisplacementFile"));
+  outLayer.roughnessFile = XmlHelper::GetString(node, TEXT("RoughnessFile"));
+}
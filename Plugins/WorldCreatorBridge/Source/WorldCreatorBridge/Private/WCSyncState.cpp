@@ -0,0 +1,138 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WCSyncState.h"
+#include "WCMappedFile.h"
+#include "Hash/xxhash.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+  // json numbers are doubles, the hashes are stored as hex strings
+  FString HashToString(uint64 hash)
+  {
+    return FString::Printf(TEXT("%016llx"), hash);
+  }
+
+  uint64 StringToHash(const FString& value)
+  {
+    return FCString::Strtoui64(*value, nullptr, 16);
+  }
+
+  FString TileKeyToString(const FIntPoint& tileKey)
+  {
+    return FString::Printf(TEXT("%d_%d"), tileKey.X, tileKey.Y);
+  }
+}
+
+bool FWCSyncState::Load(const FString& filePath)
+{
+  FString jsonString;
+  if (!FFileHelper::LoadFileToString(jsonString, *filePath))
+    return false;
+
+  TSharedPtr<FJsonObject> root;
+  TSharedRef<TJsonReader<>> reader = TJsonReaderFactory<>::Create(jsonString);
+  if (!FJsonSerializer::Deserialize(reader, root) || !root.IsValid())
+    return false;
+  if (root->GetIntegerField(TEXT("Version")) != FILE_VERSION)
+    return false;
+
+  settingsHash = StringToHash(root->GetStringField(TEXT("Settings")));
+
+  const TSharedPtr<FJsonObject>* tilesObject;
+  if (root->TryGetObjectField(TEXT("Tiles"), tilesObject))
+  {
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& tile : (*tilesObject)->Values)
+    {
+      FString x, y;
+      if (tile.Key.Split(TEXT("_"), &x, &y))
+        tileHashes.Add(FIntPoint(FCString::Atoi(*x), FCString::Atoi(*y)), StringToHash(tile.Value->AsString()));
+    }
+  }
+
+  const TSharedPtr<FJsonObject>* texturesObject;
+  if (root->TryGetObjectField(TEXT("Textures"), texturesObject))
+  {
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& texture : (*texturesObject)->Values)
+    {
+      textureHashes.Add(texture.Key, StringToHash(texture.Value->AsString()));
+    }
+  }
+
+  const TSharedPtr<FJsonObject>* landscapesObject;
+  if (root->TryGetObjectField(TEXT("Landscapes"), landscapesObject))
+  {
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& landscape : (*landscapesObject)->Values)
+    {
+      landscapeHashes.Add(FCString::Atoi(*landscape.Key), StringToHash(landscape.Value->AsString()));
+    }
+  }
+  return true;
+}
+
+bool FWCSyncState::Save(const FString& filePath) const
+{
+  TSharedRef<FJsonObject> root = MakeShared<FJsonObject>();
+  root->SetNumberField(TEXT("Version"), FILE_VERSION);
+  root->SetStringField(TEXT("Settings"), HashToString(settingsHash));
+
+  TSharedRef<FJsonObject> tilesObject = MakeShared<FJsonObject>();
+  for (const TPair<FIntPoint, uint64>& tile : tileHashes)
+  {
+    tilesObject->SetStringField(TileKeyToString(tile.Key), HashToString(tile.Value));
+  }
+  root->SetObjectField(TEXT("Tiles"), tilesObject);
+
+  TSharedRef<FJsonObject> texturesObject = MakeShared<FJsonObject>();
+  for (const TPair<FString, uint64>& texture : textureHashes)
+  {
+    texturesObject->SetStringField(texture.Key, HashToString(texture.Value));
+  }
+  root->SetObjectField(TEXT("Textures"), texturesObject);
+
+  TSharedRef<FJsonObject> landscapesObject = MakeShared<FJsonObject>();
+  for (const TPair<int, uint64>& landscape : landscapeHashes)
+  {
+    landscapesObject->SetStringField(FString::FromInt(landscape.Key), HashToString(landscape.Value));
+  }
+  root->SetObjectField(TEXT("Landscapes"), landscapesObject);
+
+  FString jsonString;
+  TSharedRef<TJsonWriter<>> writer = TJsonWriterFactory<>::Create(&jsonString);
+  if (!FJsonSerializer::Serialize(root, writer))
+    return false;
+  return FFileHelper::SaveStringToFile(jsonString, *filePath);
+}
+
+FString FWCSyncState::GetFilePath(const FString& mapName, const FString& terrainName)
+{
+  return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("WorldCreatorBridge"), FString::Printf(TEXT("%s_%s.json"), *mapName, *terrainName));
+}
+
+bool FWCSyncState::HashFile(const FString& filePath, uint64& outHash)
+{
+  // the file is mapped like the tiles, so hashing does not load it a second time
+  FWCMappedFile file;
+  if (!file.Open(filePath))
+    return false;
+  outHash = FXxHash64::HashBuffer(file.GetFileData(), file.GetFileSize()).Hash;
+  return true;
+}
+
+bool FWCSyncState::HashFiles(const TArray<FString>& filePaths, uint64& outHash)
+{
+  FXxHash64Builder builder;
+  for (const FString& filePath : filePaths)
+  {
+    uint64 fileHash;
+    if (!HashFile(filePath, fileHash))
+      return false;
+    builder.Update(&fileHash, sizeof(fileHash));
+  }
+  outHash = builder.Finalize().Hash;
+  return true;
+}
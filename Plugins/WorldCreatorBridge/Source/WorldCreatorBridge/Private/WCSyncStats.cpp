@@ -0,0 +1,172 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WCSyncStats.h"
+
+DEFINE_STAT(STAT_WCParse);
+DEFINE_STAT(STAT_WCTextureImport);
+DEFINE_STAT(STAT_WCDelete);
+DEFINE_STAT(STAT_WCTileRead);
+DEFINE_STAT(STAT_WCAssembly);
+DEFINE_STAT(STAT_WCLayerInfo);
+DEFINE_STAT(STAT_WCMaterial);
+DEFINE_STAT(STAT_WCLandscapeImport);
+DEFINE_STAT(STAT_WCBytesRead);
+DEFINE_STAT(STAT_WCBytesCopied);
+DEFINE_STAT(STAT_WCBufferMemory);
+DEFINE_STAT(STAT_WCPeakBufferMemory);
+DEFINE_STAT(STAT_WCTilesProcessed);
+
+FWCSyncStats::FScopedStage::FScopedStage(FWCSyncStats& stats, EWCSyncStage stage, int64 bytes)
+  : stats(stats)
+  , stage(stage)
+  , bytes(bytes)
+  , startCycles(FPlatformTime::Cycles64())
+  , cycleCounter(GetStageStatId(stage))
+{
+}
+
+FWCSyncStats::FScopedStage::~FScopedStage()
+{
+  stats.AddStage(stage, FPlatformTime::Cycles64() - startCycles, bytes);
+}
+
+void FWCSyncStats::Reset()
+{
+  bytesAssembled = 0;
+  bytesCopied = 0;
+  bufferBytes = 0;
+  peakBufferBytes = 0;
+  for (int i = 0; i < (int)EWCSyncStage::Num; i++)
+  {
+    stageCycles[i] = 0;
+    stageBytes[i] = 0;
+  }
+  SET_MEMORY_STAT(STAT_WCBytesRead, 0);
+  SET_MEMORY_STAT(STAT_WCBytesCopied, 0);
+  SET_MEMORY_STAT(STAT_WCBufferMemory, 0);
+  SET_MEMORY_STAT(STAT_WCPeakBufferMemory, 0);
+  SET_DWORD_STAT(STAT_WCTilesProcessed, 0);
+}
+
+void FWCSyncStats::AddAssembled(int64 bytes)
+{
+  bytesAssembled.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void FWCSyncStats::AddCopied(int64 bytes)
+{
+  bytesCopied.fetch_add(bytes, std::memory_order_relaxed);
+  INC_MEMORY_STAT_BY(STAT_WCBytesCopied, bytes);
+}
+
+void FWCSyncStats::AddStage(EWCSyncStage stage, uint64 cycles, int64 bytes)
+{
+  stageCycles[(int)stage].fetch_add(cycles, std::memory_order_relaxed);
+  stageBytes[(int)stage].fetch_add(bytes, std::memory_order_relaxed);
+
+  // every tile read stage decodes one tile
+  if (stage == EWCSyncStage::TileRead)
+  {
+    INC_MEMORY_STAT_BY(STAT_WCBytesRead, bytes);
+    INC_DWORD_STAT(STAT_WCTilesProcessed);
+  }
+}
+
+void FWCSyncStats::AddBufferBytes(int64 bytes)
+{
+  const int64 current = bufferBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  int64 peak = peakBufferBytes.load(std::memory_order_relaxed);
+  while (current > peak && !peakBufferBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+  {
+  }
+  SET_MEMORY_STAT(STAT_WCBufferMemory, current);
+  SET_MEMORY_STAT(STAT_WCPeakBufferMemory, peakBufferBytes.load(std::memory_order_relaxed));
+}
+
+int64 FWCSyncStats::GetBytesAssembled() const
+{
+  return bytesAssembled.load(std::memory_order_relaxed);
+}
+
+int64 FWCSyncStats::GetBytesCopied() const
+{
+  return bytesCopied.load(std::memory_order_relaxed);
+}
+
+double FWCSyncStats::GetStageSeconds(EWCSyncStage stage) const
+{
+  return FPlatformTime::ToSeconds64(stageCycles[(int)stage].load(std::memory_order_relaxed));
+}
+
+int64 FWCSyncStats::GetStageBytes(EWCSyncStage stage) const
+{
+  return stageBytes[(int)stage].load(std::memory_order_relaxed);
+}
+
+int64 FWCSyncStats::GetPeakBufferBytes() const
+{
+  return peakBufferBytes.load(std::memory_order_relaxed);
+}
+
+const TCHAR* FWCSyncStats::GetStageName(EWCSyncStage stage)
+{
+  switch (stage)
+  {
+  case EWCSyncStage::Parse:
+    return TEXT("Parse");
+  case EWCSyncStage::TextureImport:
+    return TEXT("Texture import");
+  case EWCSyncStage::Delete:
+    return TEXT("Delete");
+  case EWCSyncStage::TileRead:
+    return TEXT("Tile read");
+  case EWCSyncStage::Assembly:
+    return TEXT("Assembly");
+  case EWCSyncStage::LayerInfo:
+    return TEXT("Layer info");
+  case EWCSyncStage::Material:
+    return TEXT("Material");
+  case EWCSyncStage::LandscapeImport:
+    return TEXT("Landscape import");
+  default:
+    return TEXT("Unknown");
+  }
+}
+
+TStatId FWCSyncStats::GetStageStatId(EWCSyncStage stage)
+{
+  switch (stage)
+  {
+  case EWCSyncStage::Parse:
+    return GET_STATID(STAT_WCParse);
+  case EWCSyncStage::TextureImport:
+    return GET_STATID(STAT_WCTextureImport);
+  case EWCSyncStage::Delete:
+    return GET_STATID(STAT_WCDelete);
+  case EWCSyncStage::TileRead:
+    return GET_STATID(STAT_WCTileRead);
+  case EWCSyncStage::Assembly:
+    return GET_STATID(STAT_WCAssembly);
+  case EWCSyncStage::LayerInfo:
+    return GET_STATID(STAT_WCLayerInfo);
+  case EWCSyncStage::Material:
+    return GET_STATID(STAT_WCMaterial);
+  case EWCSyncStage::LandscapeImport:
+  default:
+    return GET_STATID(STAT_WCLandscapeImport);
+  }
+}
+
+void FWCSyncStats::Log(const FString& terrainName) const
+{
+  const double toMB = 1.0 / (1024.0 * 1024.0);
+  UE_LOG(LogTemp, Log, TEXT("Synced %s: %.1f MB assembled, %.1f MB copied"), *terrainName, GetBytesAssembled() * toMB, GetBytesCopied() * toMB);
+  UE_LOG(LogTemp, Log, TEXT("  peak buffer memory %.1f MB"), GetPeakBufferBytes() * toMB);
+  for (int i = 0; i < (int)EWCSyncStage::Num; i++)
+  {
+    const EWCSyncStage stage = (EWCSyncStage)i;
+    const double seconds = GetStageSeconds(stage);
+    const double megabytes = GetStageBytes(stage) * toMB;
+    UE_LOG(LogTemp, Log, TEXT("  %-16s %8.3f s %10.1f MB %10.1f MB/s"), GetStageName(stage), seconds, megabytes, seconds > 0.0 ? megabytes / seconds : 0.0);
+  }
+}
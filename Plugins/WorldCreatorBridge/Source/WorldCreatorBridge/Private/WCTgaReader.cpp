@@ -0,0 +1,164 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WCTgaReader.h"
+#include "HAL/PlatformFileManager.h"
+#include "Templates/UniquePtr.h"
+
+bool FWCTgaReader::ParseHeader(const uint8* fileData, int64 fileSize, FWCTgaHeader& outHeader)
+{
+  if (fileData == nullptr || fileSize < FWCTgaHeader::SIZE)
+    return false;
+
+  // the header is little endian and not aligned, read it byte wise
+  outHeader.idLength = fileData[0];
+  outHeader.colorMapType = fileData[1];
+  outHeader.imageType = fileData[2];
+  outHeader.colorMapLength = fileData[5] | (fileData[6] << 8);
+  outHeader.colorMapEntrySize = fileData[7];
+  outHeader.width = fileData[12] | (fileData[13] << 8);
+  outHeader.height = fileData[14] | (fileData[15] << 8);
+  outHeader.bitsPerPixel = fileData[16];
+  outHeader.descriptor = fileData[17];
+
+  const bool bTrueColor = outHeader.imageType == 2 || outHeader.imageType == 10;
+  const bool bGrayscale = outHeader.imageType == 3 || outHeader.imageType == 11;
+  if (!bTrueColor && !bGrayscale)
+  {
+    UE_LOG(LogTemp, Error, TEXT("Unsupported tga image type %d"), outHeader.imageType);
+    return false;
+  }
+  if (outHeader.bitsPerPixel % 8 != 0 || outHeader.GetBytesPerPixel() < 1 || outHeader.GetBytesPerPixel() > 4)
+  {
+    UE_LOG(LogTemp, Error, TEXT("Unsupported tga pixel depth %d"), outHeader.bitsPerPixel);
+    return false;
+  }
+  return outHeader.width > 0 && outHeader.height > 0;
+}
+
+bool FWCTgaReader::Probe(const FString& filePath, FWCTgaHeader& outHeader)
+{
+  TUniquePtr<IFileHandle> fileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*filePath));
+  if (!fileHandle.IsValid())
+    return false;
+
+  uint8 headerData[FWCTgaHeader::SIZE];
+  if (!fileHandle->Read(headerData, FWCTgaHeader::SIZE))
+    return false;
+  return ParseHeader(headerData, FWCTgaHeader::SIZE, outHeader);
+}
+
+bool FWCTgaReader::CanReadInPlace(const FWCTgaHeader& header)
+{
+  return !header.IsRle() && !header.IsTopOrigin() && !header.IsRightOrigin();
+}
+
+bool FWCTgaReader::Decode(const FWCTgaHeader& header, const uint8* fileData, int64 fileSize, uint8* dest)
+{
+  const int64 pixelOffset = header.GetPixelDataOffset();
+  const int64 imageSize = header.GetImageSize();
+  if (dest == nullptr || fileSize < pixelOffset)
+    return false;
+
+  const uint8* src = fileData + pixelOffset;
+  if (header.IsRle())
+  {
+    if (!DecodeRle(header, src, fileData + fileSize, dest))
+      return false;
+  }
+  else
+  {
+    if (fileSize - pixelOffset < imageSize)
+      return false;
+    FMemory::Memcpy(dest, src, imageSize);
+  }
+
+  if (header.IsTopOrigin())
+    FlipRows(header, dest);
+  if (header.IsRightOrigin())
+    FlipColumns(header, dest);
+  return true;
+}
+
+bool FWCTgaReader::DecodeRle(const FWCTgaHeader& header, const uint8* src, const uint8* srcEnd, uint8* dest)
+{
+  const int bpp = header.GetBytesPerPixel();
+  const int64 numPixels = (int64)header.width * header.height;
+  int64 pixel = 0;
+
+  // packets may cross scan lines, so the image is decoded as one continuous stream
+  while (pixel < numPixels)
+  {
+    if (src >= srcEnd)
+      return false;
+
+    const uint8 packetHeader = *src++;
+    const int64 count = FMath::Min<int64>((packetHeader & 0x7f) + 1, numPixels - pixel);
+    uint8* out = dest + pixel * bpp;
+
+    if (packetHeader & 0x80)
+    {
+      // run packet, one pixel value repeated count times
+      if (srcEnd - src < bpp)
+        return false;
+      if (bpp == 4)
+      {
+        uint32 value;
+        FMemory::Memcpy(&value, src, 4);
+        uint32* out32 = (uint32*)out;
+        for (int64 i = 0; i < count; i++)
+        {
+          FMemory::Memcpy(out32 + i, &value, 4);
+        }
+      }
+      else
+      {
+        for (int64 i = 0; i < count; i++)
+        {
+          FMemory::Memcpy(out + i * bpp, src, bpp);
+        }
+      }
+      src += bpp;
+    }
+    else
+    {
+      // raw packet
+      const int64 bytes = count * bpp;
+      if (srcEnd - src < bytes)
+        return false;
+      FMemory::Memcpy(out, src, bytes);
+      src += bytes;
+    }
+    pixel += count;
+  }
+  return true;
+}
+
+void FWCTgaReader::FlipRows(const FWCTgaHeader& header, uint8* image)
+{
+  const int64 rowSize = (int64)header.width * header.GetBytesPerPixel();
+  TArray<uint8> rowBuffer;
+  rowBuffer.SetNumUninitialized(rowSize);
+  for (int64 top = 0, bottom = header.height - 1; top < bottom; top++, bottom--)
+  {
+    FMemory::Memcpy(rowBuffer.GetData(), image + top * rowSize, rowSize);
+    FMemory::Memcpy(image + top * rowSize, image + bottom * rowSize, rowSize);
+    FMemory::Memcpy(image + bottom * rowSize, rowBuffer.GetData(), rowSize);
+  }
+}
+
+void FWCTgaReader::FlipColumns(const FWCTgaHeader& header, uint8* image)
+{
+  const int bpp = header.GetBytesPerPixel();
+  const int64 rowSize = (int64)header.width * bpp;
+  uint8 pixelBuffer[4];
+  for (int64 row = 0; row < header.height; row++)
+  {
+    uint8* rowData = image + row * rowSize;
+    for (int64 left = 0, right = header.width - 1; left < right; left++, right--)
+    {
+      FMemory::Memcpy(pixelBuffer, rowData + left * bpp, bpp);
+      FMemory::Memcpy(rowData + left * bpp, rowData + right * bpp, bpp);
+      FMemory::Memcpy(rowData + right * bpp, pixelBuffer, bpp);
+    }
+  }
+}
@@ -0,0 +1,160 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WCTileAssembly.h"
+#include "WCTileCache.h"
+#include "WCBlit.h"
+#include "WCSplatKernels.h"
+
+namespace
+{
+  // BytesPerPixel 0 reads the pixel size from the tile
+  template<int BytesPerPixel>
+  FORCEINLINE void DeinterleaveRow(const uint8* src, int32 count, int bytesPerPixel, int numChannels, uint8* const* planes)
+  {
+    if constexpr (BytesPerPixel == 4)
+    {
+      FWCSplatKernels::DeinterleaveBGRA(src, count, planes);
+    }
+    else if constexpr (BytesPerPixel == 0)
+    {
+      FWCSplatKernels::Deinterleave(src, count, bytesPerPixel, numChannels, planes);
+    }
+    else
+    {
+      FWCSplatKernels::DeinterleaveFixed<BytesPerPixel>(src, count, numChannels, planes);
+    }
+  }
+
+  template<bool bBottomUp, bool bImportLayers, int BytesPerPixel>
+  void AssembleTileRect(const FWCTileRect& rect)
+  {
+    const WCLandscapeTile& tile = *rect.tile;
+    const int64 srcStride = tile.width;
+
+    // world creator rows are landscape columns, version 3 tiles are additionally stored bottom up
+    const uint16* heightMap = (const uint16*)tile.heightmap.GetData();
+    uint16* heightDest = rect.heightData + rect.destOffset;
+    if constexpr (bBottomUp)
+    {
+      const uint16* heightSrc = heightMap + (int64)(tile.height - rect.srcY - rect.length) * srcStride + rect.srcX;
+      FWCBlit::Blit16(heightSrc, srcStride, heightDest, rect.destStride, rect.width, rect.length, EWCBlitOrientation::Transpose | EWCBlitOrientation::FlipY);
+    }
+    else
+    {
+      const uint16* heightSrc = heightMap + (int64)rect.srcY * srcStride + rect.srcX;
+      FWCBlit::Blit16(heightSrc, srcStride, heightDest, rect.destStride, rect.width, rect.length, EWCBlitOrientation::Transpose);
+    }
+
+    if constexpr (bImportLayers)
+    {
+      const int bytesPerPixel = BytesPerPixel > 0 ? BytesPerPixel : tile.Bpp;
+      TArray<uint8>* splatRows = rect.splatRows;
+
+      // splatmaps are split into planes one band of rows at a time, then the band is blitted like the heights
+      const int32 bandSize = rect.width * FWCBlit::BLOCK_SIZE;
+      for (int k = 0; k < FWCSplatKernels::MAX_CHANNELS; k++)
+      {
+        if (splatRows[k].Num() < bandSize)
+          splatRows[k].SetNumUninitialized(bandSize);
+      }
+
+      for (int bandY = 0; bandY < rect.length; bandY += FWCBlit::BLOCK_SIZE)
+      {
+        const int bandLength = FMath::Min((int)FWCBlit::BLOCK_SIZE, rect.length - bandY);
+        for (int j = 0; j < tile.splatmaps.Num(); j++)
+        {
+          const int numChannels = rect.splatChannelCounts[j];
+          const uint8* splatmap = tile.splatmaps[j].GetData();
+          for (int y = 0; y < bandLength; y++)
+          {
+            uint8* planes[FWCSplatKernels::MAX_CHANNELS] = { nullptr, nullptr, nullptr, nullptr };
+            for (int k = 0; k < numChannels; k++)
+            {
+              planes[k] = splatRows[k].GetData() + y * rect.width;
+            }
+            const int64 srcY = rect.srcY + bandY + y;
+            DeinterleaveRow<BytesPerPixel>(splatmap + (rect.srcX + srcY * srcStride) * bytesPerPixel, rect.width, bytesPerPixel, numChannels, planes);
+          }
+
+          for (int k = 0; k < numChannels; k++)
+          {
+            uint8* splatDest = rect.splatLayers[j * 4 + k] + rect.destOffset + bandY;
+            FWCBlit::Blit8(splatRows[k].GetData(), rect.width, splatDest, rect.destStride, rect.width, bandLength, EWCBlitOrientation::Transpose);
+          }
+        }
+      }
+    }
+  }
+
+  template<bool bBottomUp>
+  FWCTileAssembly::FKernel GetLayerKernel(int bytesPerPixel)
+  {
+    switch (bytesPerPixel)
+    {
+    case 1:
+      return &AssembleTileRect<bBottomUp, true, 1>;
+    case 2:
+      return &AssembleTileRect<bBottomUp, true, 2>;
+    case 3:
+      return &AssembleTileRect<bBottomUp, true, 3>;
+    case 4:
+      return &AssembleTileRect<bBottomUp, true, 4>;
+    default:
+      return &AssembleTileRect<bBottomUp, true, 0>;
+    }
+  }
+}
+
+FWCTileAssembly::FKernel FWCTileAssembly::GetKernel(int version, bool bImportLayers, int bytesPerPixel)
+{
+  const bool bBottomUp = version >= 3;
+  if (!bImportLayers)
+  {
+    return bBottomUp ? &AssembleTileRect<true, false, 0> : &AssembleTileRect<false, false, 0>;
+  }
+  return bBottomUp ? GetLayerKernel<true>(bytesPerPixel) : GetLayerKernel<false>(bytesPerPixel);
+}
+
+void FWCTileAssembly::BuildPlan(int startX, int startY, int destWidth, int destLength, int tileWidth, int tileLength,
+  int terrainWidth, int terrainLength, TArray<FWCBlitPlanEntry>& outPlan)
+{
+  outPlan.Reset();
+  if (tileWidth <= 0 || tileLength <= 0)
+    return;
+
+  for (int destX = 0; destX < destWidth;)
+  {
+    const int x = startX + destX;
+    const int tileX = x / tileWidth;
+    const int srcX = x % tileWidth;
+    const int tileWidthLeft = FMath::Min(tileWidth, terrainWidth - tileX * tileWidth) - srcX;
+    const int rectWidth = FMath::Min(tileWidthLeft, destWidth - destX);
+    if (rectWidth <= 0)
+      break;
+
+    for (int destY = 0; destY < destLength;)
+    {
+      const int y = startY + destY;
+      const int tileY = y / tileLength;
+      const int srcY = y % tileLength;
+      const int tileLengthLeft = FMath::Min(tileLength, terrainLength - tileY * tileLength) - srcY;
+      const int rectLength = FMath::Min(tileLengthLeft, destLength - destY);
+      if (rectLength <= 0)
+        break;
+
+      for (int strip = 0; strip < rectLength; strip += STRIP_LENGTH)
+      {
+        FWCBlitPlanEntry& entry = outPlan.AddDefaulted_GetRef();
+        entry.tileKey = FIntPoint(tileX, tileY);
+        entry.srcX = srcX;
+        entry.srcY = srcY + strip;
+        entry.width = rectWidth;
+        entry.length = FMath::Min(STRIP_LENGTH, rectLength - strip);
+        entry.destX = destX;
+        entry.destY = destY + strip;
+      }
+      destY += rectLength;
+    }
+    destX += rectWidth;
+  }
+}
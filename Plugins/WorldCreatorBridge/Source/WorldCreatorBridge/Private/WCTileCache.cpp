@@ -0,0 +1,121 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WCTileCache.h"
+
+int64 WCLandscapeTile::GetAllocatedSize() const
+{
+  // mapped views are counted as well, they stay resident in the page cache while the tile is in use
+  int64 size = heightmap.GetFileSize() + splatmaps.GetAllocatedSize();
+  for (const FWCMappedFile& splatmap : splatmaps)
+  {
+    size += splatmap.GetFileSize();
+  }
+  return size;
+}
+
+FWCTileCache::FWCTileCache(int64 budgetBytes)
+  : budget(budgetBytes)
+{
+}
+
+TSharedPtr<WCLandscapeTile> FWCTileCache::FindOrLoad(const FIntPoint& key, TFunctionRef<TSharedPtr<WCLandscapeTile>()> loader)
+{
+  TPromise<TSharedPtr<WCLandscapeTile>> promise;
+  {
+    FScopeLock scopeLock(&lock);
+    if (FEntry* entry = entries.Find(key))
+    {
+      entry->lastUse = ++useCounter;
+      return entry->tile;
+    }
+    if (const TSharedFuture<TSharedPtr<WCLandscapeTile>>* pendingLoad = loading.Find(key))
+    {
+      // wait outside of the lock, the loading caller needs it to publish the tile
+      const TSharedFuture<TSharedPtr<WCLandscapeTile>> future = *pendingLoad;
+      scopeLock.Unlock();
+      return future.Get();
+    }
+    loading.Add(key, promise.GetFuture().Share());
+  }
+
+  TSharedPtr<WCLandscapeTile> tile = loader();
+  {
+    FScopeLock scopeLock(&lock);
+    loading.Remove(key);
+    if (tile.IsValid())
+      AddLocked(key, tile);
+  }
+  promise.SetValue(tile);
+  return tile;
+}
+
+void FWCTileCache::AddLocked(const FIntPoint& key, TSharedPtr<WCLandscapeTile> tile)
+{
+  if (FEntry* existing = entries.Find(key))
+  {
+    usedBytes -= existing->sizeBytes;
+  }
+
+  FEntry& entry = entries.Add(key);
+  entry.sizeBytes = tile->GetAllocatedSize();
+  entry.tile = MoveTemp(tile);
+  entry.lastUse = ++useCounter;
+  usedBytes += entry.sizeBytes;
+
+  EvictToBudget();
+}
+
+void FWCTileCache::Empty()
+{
+  FScopeLock scopeLock(&lock);
+  entries.Empty();
+  usedBytes = 0;
+  useCounter = 0;
+}
+
+void FWCTileCache::SetBudget(int64 budgetBytes)
+{
+  FScopeLock scopeLock(&lock);
+  budget = FMath::Max<int64>(0, budgetBytes);
+  EvictToBudget();
+}
+
+int64 FWCTileCache::GetBudget() const
+{
+  FScopeLock scopeLock(&lock);
+  return budget;
+}
+
+int64 FWCTileCache::GetUsedBytes() const
+{
+  FScopeLock scopeLock(&lock);
+  return usedBytes;
+}
+
+int32 FWCTileCache::Num() const
+{
+  FScopeLock scopeLock(&lock);
+  return entries.Num();
+}
+
+void FWCTileCache::EvictToBudget()
+{
+  // the most recently used tile is always kept, even if it alone exceeds the budget
+  while (usedBytes > budget && entries.Num() > 1)
+  {
+    const FIntPoint* oldestKey = nullptr;
+    uint64 oldestUse = MAX_uint64;
+    for (const TPair<FIntPoint, FEntry>& pair : entries)
+    {
+      if (pair.Value.lastUse < oldestUse)
+      {
+        oldestUse = pair.Value.lastUse;
+        oldestKey = &pair.Key;
+      }
+    }
+
+    const FIntPoint key = *oldestKey;
+    usedBytes -= entries[key].sizeBytes;
+    entries.Remove(key);
+  }
+}
@@ -0,0 +1,128 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WorldCreatorBenchmarkCommandlet.h"
+#include "WorldCreatorBridge.h"
+#include "WCSyncGenerator.h"
+#include "WCSyncSettings.h"
+#include "WCSyncStats.h"
+#include "WCCommandletHelper.h"
+#include "FileHelpers.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+UWorldCreatorBenchmarkCommandlet::UWorldCreatorBenchmarkCommandlet()
+{
+  IsClient = false;
+  IsServer = false;
+  IsEditor = true;
+  LogToConsole = true;
+
+  HelpDescription = TEXT("Imports a synthetic World Creator sync and reports the time and throughput of every import stage");
+  HelpUsage = TEXT("UnrealEditor-Cmd <Project> -run=WorldCreatorBenchmark [-Version=3] [-TileResolution=1024] [-Tiles=2] [-Layers=4] [options] -nullrhi");
+  HelpParamNames = {
+    TEXT("Version"), TEXT("TileResolution"), TEXT("Tiles"), TEXT("TilesX"), TEXT("TilesY"), TEXT("Layers"), TEXT("Seed"), TEXT("Dir"),
+    TEXT("QuadsPerSection"), TEXT("Resolution"), TEXT("WorldPartition"), TEXT("Stream"), TEXT("NoLayers"), TEXT("Keep") };
+  HelpParamDescriptions = {
+    TEXT("3 for the tiled layout, 2 for the single file layout"),
+    TEXT("Resolution of one World Creator tile"),
+    TEXT("Number of tiles in both directions"),
+    TEXT("Number of tiles along x"),
+    TEXT("Number of tiles along y"),
+    TEXT("Number of texturing layers"),
+    TEXT("Seed of the generated data"),
+    TEXT("Folder the sync is generated in, defaults to Saved/WorldCreatorBridge/Benchmark"),
+    TEXT("Quads per landscape section"),
+    TEXT("Maximum resolution of one landscape"),
+    TEXT("Import into a world partition map"),
+    TEXT("Write the landscapes region by region"),
+    TEXT("Skip the import of the splatmap layers"),
+    TEXT("Keep the generated folder") };
+}
+
+int32 UWorldCreatorBenchmarkCommandlet::Main(const FString& Params)
+{
+  TArray<FString> tokens;
+  TArray<FString> switches;
+  TMap<FString, FString> params;
+  ParseCommandLine(*Params, tokens, switches, params);
+
+  FWCSyncGeneratorSettings generatorSettings;
+  generatorSettings.directory = FPaths::ProjectSavedDir() / TEXT("WorldCreatorBridge/Benchmark");
+  WCCommandletHelper::GetInt(params, TEXT("Version"), generatorSettings.version);
+  WCCommandletHelper::GetInt(params, TEXT("TileResolution"), generatorSettings.tileResolution);
+  int tiles = 0;
+  WCCommandletHelper::GetInt(params, TEXT("Tiles"), tiles);
+  if (tiles > 0)
+  {
+    generatorSettings.tilesX = tiles;
+    generatorSettings.tilesY = tiles;
+  }
+  WCCommandletHelper::GetInt(params, TEXT("TilesX"), generatorSettings.tilesX);
+  WCCommandletHelper::GetInt(params, TEXT("TilesY"), generatorSettings.tilesY);
+  WCCommandletHelper::GetInt(params, TEXT("Layers"), generatorSettings.numLayers);
+  WCCommandletHelper::GetInt(params, TEXT("Seed"), generatorSettings.seed);
+  WCCommandletHelper::GetString(params, TEXT("Dir"), generatorSettings.directory);
+
+  // every run is a full import without textures, they are not part of the generated data
+  FWCSyncSettings settings;
+  settings.terrainName = TEXT("WC_Benchmark");
+  settings.bImportTextures = false;
+  settings.bIncrementalSync = false;
+  settings.bBuildMinimap = false;
+  settings.bUseWorldPartition = switches.Contains(TEXT("WorldPartition"));
+  settings.bStreamImport = switches.Contains(TEXT("Stream"));
+  settings.bImportLayers = !switches.Contains(TEXT("NoLayers"));
+  WCCommandletHelper::GetInt(params, TEXT("QuadsPerSection"), settings.quadsPerSection);
+  WCCommandletHelper::GetInt(params, TEXT("Resolution"), settings.landscapeResolution);
+
+  //// Generate the sync folder
+  const double toMB = 1.0 / (1024.0 * 1024.0);
+  IFileManager::Get().DeleteDirectory(*generatorSettings.directory, false, true);
+  double startTime = FPlatformTime::Seconds();
+  settings.bridgeFilePath = FWCSyncGenerator::Generate(generatorSettings);
+  if (settings.bridgeFilePath.Len() <= 0)
+  {
+    UE_LOG(LogTemp, Error, TEXT("Failed to generate the sync folder %s"), *generatorSettings.directory);
+    return 1;
+  }
+  const double dataMB = FWCSyncGenerator::GetDataSize(generatorSettings) * toMB;
+  UE_LOG(LogTemp, Display, TEXT("Generated %.1f MB (version %d, %d x %d tiles of %d, %d layers) in %.2f s"), dataMB, generatorSettings.version,
+    generatorSettings.tilesX, generatorSettings.tilesY, generatorSettings.tileResolution, generatorSettings.numLayers, FPlatformTime::Seconds() - startTime);
+
+  //// Import it into an empty map
+  UWorld* world = UEditorLoadingAndSavingUtils::NewBlankMap(false);
+  if (world == nullptr)
+  {
+    UE_LOG(LogTemp, Error, TEXT("Failed to create a map for the benchmark"));
+    return 1;
+  }
+
+  FWorldCreatorBridgeModule& bridge = FModuleManager::LoadModuleChecked<FWorldCreatorBridgeModule>("WorldCreatorBridge");
+  startTime = FPlatformTime::Seconds();
+  const bool bSynced = bridge.RunSync(world, settings);
+  const double totalSeconds = FPlatformTime::Seconds() - startTime;
+  if (!bSynced)
+  {
+    UE_LOG(LogTemp, Error, TEXT("Benchmark sync failed"));
+    return 1;
+  }
+
+  //// Report
+  const FWCSyncStats& stats = bridge.GetSyncStats();
+  UE_LOG(LogTemp, Display, TEXT("%-16s %10s %10s %10s"), TEXT("Stage"), TEXT("Time (s)"), TEXT("MB"), TEXT("MB/s"));
+  for (int i = 0; i < (int)EWCSyncStage::Num; i++)
+  {
+    const EWCSyncStage stage = (EWCSyncStage)i;
+    const double seconds = stats.GetStageSeconds(stage);
+    const double megabytes = stats.GetStageBytes(stage) * toMB;
+    UE_LOG(LogTemp, Display, TEXT("%-16s %10.3f %10.1f %10.1f"), FWCSyncStats::GetStageName(stage), seconds, megabytes, seconds > 0.0 ? megabytes / seconds : 0.0);
+  }
+  UE_LOG(LogTemp, Display, TEXT("%-16s %10.3f %10.1f %10.1f"), TEXT("Total"), totalSeconds, dataMB, totalSeconds > 0.0 ? dataMB / totalSeconds : 0.0);
+  UE_LOG(LogTemp, Display, TEXT("Stages on worker threads add up the time of all threads, the total is wall time"));
+
+  if (!switches.Contains(TEXT("Keep")))
+  {
+    IFileManager::Get().DeleteDirectory(*generatorSettings.directory, false, true);
+  }
+  return 0;
+}
@@ -38,6 +38,10 @@
 #include "LandscapeGizmoActiveActor.h"
 #include "WorldPartition/LoaderAdapter/LoaderAdapterShape.h"
 #include "LandscapeConfigHelper.h"
+#include "LandscapeEdit.h"
+#include "LandscapeDataAccess.h"
+#include "LandscapeComponent.h"
+#include "LandscapeHeightfieldCollisionComponent.h"
 #include "Editor/LandscapeEditor/Public/LandscapeEditorObject.h" // dannach is eher fragwrdig
 #include "Editor/LandscapeEditor/Private/LandscapeRegionUtils.h"
 #include "Editor/LandscapeEditor/Public/LandscapeImportHelper.h"
@@ -63,6 +67,14 @@
 #include "EditorModeManager.h"
 #include "EditorModes.h"	
 #include "Containers/Array.h"
+#include "Tasks/Task.h"
+#include "Async/ParallelFor.h"
+#include "WCTileAssembly.h"
+#include "WCSplatKernels.h"
+#include "WCSyncJob.h"
+#include "WCImportReport.h"
+#include "Interfaces/IPluginManager.h"
+#include "Hash/xxhash.h"
 
 // materials
 #include "Factories/MaterialFactoryNew.h"
@@ -80,6 +92,12 @@
 #include "Materials/MaterialExpressionAdd.h"
 #include "Materials/MaterialExpressionComponentMask.h"
 #include "Materials/MaterialExpressionAppendVector.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "UObject/MetaData.h"
+#include "WCMaterialGraphBuilder.h"
+#include "Engine/Texture2DArray.h"
+#include "RHIGlobals.h"
+#include "ImageCore.h"
 
 // File System
 #include "HAL/FileManagerGeneric.h"
@@ -102,9 +120,31 @@ static const int WC_TILE_RESOLUTION = 4096;
 static const int WC_BASE_RESOLUTION = 1024;
 static const int UNREAL_MIN_TILE_RESOLUTION = 64;
 static const float UNREAL_TERRAIN_SCALE_FACTOR = 0.1953125f;
+static const int ASSEMBLE_PIPELINE_DEPTH = 1;
+static const int STREAM_REGION_COMPONENTS = 4;
+static const FName MAPPING_WIDTH_PARAMETER("MappingWidth");
+static const FName MAPPING_LENGTH_PARAMETER("MappingLength");
+static const TCHAR* COLORMAP_OFFSET_PARAMETER = TEXT("ColormapOffset");
+static const TCHAR* COLORMAP_TEXTURE_PARAMETER = TEXT("Colormap");
+static const float UNUSED_SLOT_OFFSET = 1.0e6f;
+static const FName LANDSCAPE_ORIGIN_PARAMETER("LandscapeOrigin");
+// package metadata of the parent material, increase the version whenever CreateParentMaterial builds a different graph
+static const FName MATERIAL_GRAPH_HASH_KEY("WorldCreatorGraphHash");
+static const int MATERIAL_GRAPH_VERSION = 3;
+// package metadata of a packed layer texture, the ao, roughness and displacement files it was packed from
+static const FName PACKED_SOURCES_KEY("WorldCreatorPackedSources");
+// maps of a texturing layer that get their own texture array, LAYER_MAP_PACKED is the texture of PackLayerTextures
+enum ELayerMap { LAYER_MAP_ALBEDO, LAYER_MAP_NORMAL, LAYER_MAP_AO, LAYER_MAP_DISPLACEMENT, LAYER_MAP_ROUGHNESS, LAYER_MAP_PACKED, LAYER_MAP_COUNT };
+static const TCHAR* LAYER_MAP_NAMES[LAYER_MAP_COUNT] = { TEXT("albedo"), TEXT("normal"), TEXT("ao"), TEXT("displacement"), TEXT("roughness"), TEXT("packed") };
 #define LOCTEXT_NAMESPACE "FWorldCreatorBridgeModule"
 
 
+FWCAssembledTile::~FWCAssembledTile()
+{
+  if (stats != nullptr)
+    stats->AddBufferBytes(-bufferBytes);
+}
+
 void FWorldCreatorBridgeModule::StartupModule()
 {
   // This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
@@ -143,6 +183,12 @@ void FWorldCreatorBridgeModule::ShutdownModule()
 
   FWorldCreatorBridgeCommands::Unregister();
 
+  if (syncJob.IsValid())
+  {
+    syncJob->Stop();
+    syncJob.Reset();
+  }
+
   FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(WorldCreatorBridgeTabName);
 }
 
@@ -259,7 +305,7 @@ TSharedRef<SDockTab> FWorldCreatorBridgeModule::OnSpawnPluginTab(const FSpawnTab
               SNew(SHorizontalBox)
                 + SHorizontalBox::Slot().FillWidth(1)
                 [
-                  SNew(SButton)
+                  SNew(SButton).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle)
                     .Text(FText::FromString("Select Bridge File")).OnClicked(
                       FOnClicked::CreateRaw(this, &FWorldCreatorBridgeModule::BrowseButtonClicked))
                     .ToolTipText(FText::FromString("By default the path points to the World Creator Sync Folder. You only need to change it if you want to sync a file from a different location."))
@@ -289,7 +335,7 @@ TSharedRef<SDockTab> FWorldCreatorBridgeModule::OnSpawnPluginTab(const FSpawnTab
                 ]
                 + SHorizontalBox::Slot().FillWidth(1)
                 [
-                  SNew(SEditableTextBox).Text(FText::FromString("WC_Terrain")).OnTextChanged(
+                  SNew(SEditableTextBox).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle).Text(FText::FromString("WC_Terrain")).OnTextChanged(
                     FOnTextChanged::CreateLambda([this](const FText& InText)
                       {
                         this->terrainName = InText.ToString();
@@ -311,7 +357,7 @@ TSharedRef<SDockTab> FWorldCreatorBridgeModule::OnSpawnPluginTab(const FSpawnTab
                 ]
                 + SHorizontalBox::Slot().FillWidth(1)
                 [
-                  SNew(SEditableTextBox).Text(FText::FromString("M_Terrain")).OnTextChanged(
+                  SNew(SEditableTextBox).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle).Text(FText::FromString("M_Terrain")).OnTextChanged(
                     FOnTextChanged::CreateLambda([this](const FText& InText)
                       {
                         this->terrainMaterialName = InText.ToString();
@@ -325,7 +371,7 @@ TSharedRef<SDockTab> FWorldCreatorBridgeModule::OnSpawnPluginTab(const FSpawnTab
               SNew(SHorizontalBox)
                 + SHorizontalBox::Slot().AutoWidth()
                 [
-                  SNew(SComboButton)
+                  SNew(SComboButton).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle)
                     .OnGetMenuContent_Static(&FWorldCreatorBridgeModule::GetSectionSizeMenu, this)
                     .ContentPadding(2)
                     .ButtonContent()
@@ -358,7 +404,7 @@ TSharedRef<SDockTab> FWorldCreatorBridgeModule::OnSpawnPluginTab(const FSpawnTab
                 ]
                 + SHorizontalBox::Slot().FillWidth(1)
                 [
-                  SNew(SNumericEntryBox<int>)
+                  SNew(SNumericEntryBox<int>).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle)
                     .MinValue(63)
                     .Value_Raw(this, &FWorldCreatorBridgeModule::GetCutSizeDelta)
                     .OnValueChanged(FOnInt32ValueChanged::CreateLambda([this](int value)
@@ -390,7 +436,7 @@ TSharedRef<SDockTab> FWorldCreatorBridgeModule::OnSpawnPluginTab(const FSpawnTab
 
                 + SHorizontalBox::Slot().AutoWidth()
                 [
-                  SNew(SCheckBox).IsChecked(ECheckBoxState::Checked).OnCheckStateChanged(
+                  SNew(SCheckBox).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle).IsChecked(ECheckBoxState::Checked).OnCheckStateChanged(
                     FOnCheckStateChanged::CreateLambda([this](const ECheckBoxState& state)
                       {
                         this->bImportTextures = state == ECheckBoxState::Checked;
@@ -412,7 +458,7 @@ TSharedRef<SDockTab> FWorldCreatorBridgeModule::OnSpawnPluginTab(const FSpawnTab
 
                 + SHorizontalBox::Slot().AutoWidth()
                 [
-                  SNew(SCheckBox).IsChecked(ECheckBoxState::Checked).OnCheckStateChanged(
+                  SNew(SCheckBox).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle).IsChecked(ECheckBoxState::Checked).OnCheckStateChanged(
                     FOnCheckStateChanged::CreateLambda([this](const ECheckBoxState& state)
                       {
                         this->bImportLayers = state == ECheckBoxState::Checked;
@@ -435,7 +481,7 @@ TSharedRef<SDockTab> FWorldCreatorBridgeModule::OnSpawnPluginTab(const FSpawnTab
 
                 + SHorizontalBox::Slot().AutoWidth()
                 [
-                  SNew(SCheckBox).IsChecked(ECheckBoxState::Unchecked).OnCheckStateChanged(
+                  SNew(SCheckBox).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle).IsChecked(ECheckBoxState::Unchecked).OnCheckStateChanged(
                     FOnCheckStateChanged::CreateLambda([this](const ECheckBoxState& state)
                       {
                         this->bUseWorldPartition = state == ECheckBoxState::Checked;
@@ -443,6 +489,116 @@ TSharedRef<SDockTab> FWorldCreatorBridgeModule::OnSpawnPluginTab(const FSpawnTab
                   )
                 ]
             ]
+            + SScrollBox::Slot().HAlign(HAlign_Left).Padding(FMargin(10.0f, 10.0f, 0.0f, 0.0f))
+            [
+              SNew(SHorizontalBox)
+                + SHorizontalBox::Slot().AutoWidth()
+                [
+                  SNew(SBox).WidthOverride(100)
+                    [
+                      SNew(STextBlock).Text(FText::FromString("Stream Import"))
+                        .ToolTipText(FText::FromString("Write the landscapes region by region instead of importing them at once. Uses less memory for large terrains."))
+                    ]
+                ]
+
+                + SHorizontalBox::Slot().AutoWidth()
+                [
+                  SNew(SCheckBox).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle).IsChecked(ECheckBoxState::Unchecked).OnCheckStateChanged(
+                    FOnCheckStateChanged::CreateLambda([this](const ECheckBoxState& state)
+                      {
+                        this->bStreamImport = state == ECheckBoxState::Checked;
+                      })
+                  )
+                ]
+            ]
+            + SScrollBox::Slot().HAlign(HAlign_Left).Padding(FMargin(10.0f, 10.0f, 0.0f, 0.0f))
+            [
+              SNew(SHorizontalBox)
+                + SHorizontalBox::Slot().AutoWidth()
+                [
+                  SNew(SBox).WidthOverride(100)
+                    [
+                      SNew(STextBlock).Text(FText::FromString("Incremental Sync"))
+                        .ToolTipText(FText::FromString("Only re-import the landscapes whose World Creator tiles changed since the last sync. Uncheck to rebuild the whole terrain."))
+                    ]
+                ]
+
+                + SHorizontalBox::Slot().AutoWidth()
+                [
+                  SNew(SCheckBox).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle).IsChecked(ECheckBoxState::Checked).OnCheckStateChanged(
+                    FOnCheckStateChanged::CreateLambda([this](const ECheckBoxState& state)
+                      {
+                        this->bIncrementalSync = state == ECheckBoxState::Checked;
+                      })
+                  )
+                ]
+            ]
+            + SScrollBox::Slot().HAlign(HAlign_Left).Padding(FMargin(10.0f, 10.0f, 0.0f, 0.0f))
+            [
+              SNew(SHorizontalBox)
+                + SHorizontalBox::Slot().AutoWidth()
+                [
+                  SNew(SBox).WidthOverride(100)
+                    [
+                      SNew(STextBlock).Text(FText::FromString("Update In Place"))
+                        .ToolTipText(FText::FromString("Write changed tiles into the existing landscapes instead of deleting and importing them again. Only used by incremental syncs."))
+                    ]
+                ]
+
+                + SHorizontalBox::Slot().AutoWidth()
+                [
+                  SNew(SCheckBox).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle).IsChecked(ECheckBoxState::Checked).OnCheckStateChanged(
+                    FOnCheckStateChanged::CreateLambda([this](const ECheckBoxState& state)
+                      {
+                        this->bUpdateInPlace = state == ECheckBoxState::Checked;
+                      })
+                  )
+                ]
+            ]
+            + SScrollBox::Slot().HAlign(HAlign_Left).Padding(FMargin(10.0f, 10.0f, 0.0f, 0.0f))
+            [
+              SNew(SHorizontalBox)
+                + SHorizontalBox::Slot().AutoWidth()
+                [
+                  SNew(SBox).WidthOverride(100)
+                    [
+                      SNew(STextBlock).Text(FText::FromString("Pack Textures"))
+                        .ToolTipText(FText::FromString("Pack ambient occlusion, roughness and displacement of every layer into one texture. The material samples it once instead of three times."))
+                    ]
+                ]
+
+                + SHorizontalBox::Slot().AutoWidth()
+                [
+                  SNew(SCheckBox).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle).IsChecked(ECheckBoxState::Unchecked).OnCheckStateChanged(
+                    FOnCheckStateChanged::CreateLambda([this](const ECheckBoxState& state)
+                      {
+                        this->bPackLayerTextures = state == ECheckBoxState::Checked;
+                      })
+                  )
+                ]
+            ]
+            + SScrollBox::Slot().HAlign(HAlign_Left).Padding(FMargin(10.0f, 10.0f, 0.0f, 0.0f))
+            [
+              SNew(SHorizontalBox)
+                + SHorizontalBox::Slot().AutoWidth()
+                [
+                  SNew(SBox).WidthOverride(100)
+                    [
+                      SNew(STextBlock).Text(FText::FromString("Layer Arrays"))
+                        .ToolTipText(FText::FromString("Put the layer textures of each map type into one texture array. The number of samplers of the landscape material stays the same no matter how many layers there are."))
+                    ]
+                ]
+
+                + SHorizontalBox::Slot().AutoWidth()
+                [
+                  SNew(SCheckBox).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle).IsChecked(ECheckBoxState::Unchecked).OnCheckStateChanged(
+                    FOnCheckStateChanged::CreateLambda([this](const ECheckBoxState& state)
+                      {
+                        this->bLayerTextureArrays = state == ECheckBoxState::Checked;
+                      })
+                  )
+                ]
+            ]
             + SScrollBox::Slot().HAlign(HAlign_Left).Padding(FMargin(0.0f, 10.0f, 0.0f, 0.0f))
             [
               SNew(SHorizontalBox)
@@ -457,7 +613,7 @@ TSharedRef<SDockTab> FWorldCreatorBridgeModule::OnSpawnPluginTab(const FSpawnTab
 
                 + SHorizontalBox::Slot().AutoWidth()
                 [
-                  SNew(SNumericEntryBox<int>)
+                  SNew(SNumericEntryBox<int>).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle)
                     .AllowSpin(true)
                     .MinValue(1)
                     .MaxValue(64)
@@ -485,7 +641,7 @@ TSharedRef<SDockTab> FWorldCreatorBridgeModule::OnSpawnPluginTab(const FSpawnTab
 
                 + SHorizontalBox::Slot().AutoWidth()
                 [
-                  SNew(SNumericEntryBox<int>)
+                  SNew(SNumericEntryBox<int>).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle)
                     .AllowSpin(true)
                     .MinValue(1)
                     .MaxValue(64)
@@ -513,7 +669,7 @@ TSharedRef<SDockTab> FWorldCreatorBridgeModule::OnSpawnPluginTab(const FSpawnTab
 
                 + SHorizontalBox::Slot().AutoWidth()
                 [
-                  SNew(SNumericEntryBox<float>)
+                  SNew(SNumericEntryBox<float>).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle)
                     .AllowSpin(true)
                     .MinValue(0)
                     .MaxValue(1000)
@@ -527,6 +683,34 @@ TSharedRef<SDockTab> FWorldCreatorBridgeModule::OnSpawnPluginTab(const FSpawnTab
 
                 ]
             ]
+            + SScrollBox::Slot().HAlign(HAlign_Left).Padding(FMargin(0.0f, 10.0f, 0.0f, 0.0f))
+            [
+              SNew(SHorizontalBox)
+                + SHorizontalBox::Slot().AutoWidth().Padding(10.0f, 0, 0, 0)
+                [
+                  SNew(SBox).WidthOverride(100)
+                    [
+                      SNew(STextBlock).Text(FText::FromString("Tile Cache (MB)"))
+                        .ToolTipText(FText::FromString("Memory budget for World Creator tiles that are kept in memory during a sync. Tiles shared by multiple terrains are only read once as long as they fit into this budget."))
+                    ]
+                ]
+
+                + SHorizontalBox::Slot().AutoWidth()
+                [
+                  SNew(SNumericEntryBox<int>).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle)
+                    .AllowSpin(true)
+                    .MinValue(0)
+                    .MaxValue(65536)
+                    .Value_Raw(this, &FWorldCreatorBridgeModule::GetTileCacheBudgetDelta)
+                    .MinSliderValue(0)
+                    .MaxSliderValue(16384)
+                    .OnValueChanged(FOnInt32ValueChanged::CreateLambda([this](int value)
+                      {
+                        this->tileCacheBudgetMB = value;
+                      }))
+
+                ]
+            ]
 
 
             + SScrollBox::Slot()
@@ -536,7 +720,7 @@ TSharedRef<SDockTab> FWorldCreatorBridgeModule::OnSpawnPluginTab(const FSpawnTab
                   SNew(SHorizontalBox)
                     + SHorizontalBox::Slot().FillWidth(1).Padding(10, 20, 10, 0)
                     [
-                      SNew(SButton)
+                      SNew(SButton).IsEnabled_Raw(this, &FWorldCreatorBridgeModule::IsSyncIdle)
                         .OnClicked(FOnClicked::CreateRaw(
                           this, &FWorldCreatorBridgeModule::SyncButtonClicked))
                         [
@@ -621,18 +805,7 @@ void FWorldCreatorBridgeModule::RegisterMenus()
 
 void FWorldCreatorBridgeModule::SetupUIElements()
 {
-  FString teststring = FPlatformProcess::UserDir();
-  this->selectedPath = FString::Printf(TEXT("%sWorld Creator/Sync/Bridge.xml"), teststring.GetCharArray().GetData());
-  this->terrainName = TEXT("WC_Terrain");
-  this->terrainMaterialName = TEXT("M_Terrain");
-  this->bImportTextures = true;
-  this->bImportLayers = true;
-  this->bBuildMinimap = false;
-  this->worldScale = 1.0f;
-  this->worldPartitionGridSize = 2;
-  this->worldPartitionRegionSize = 16;
-  this->unrealTerrainResolution = 4033;
-  quatsPerSection = 63;
+  ApplySyncSettings(FWCSyncSettings());
   // Init Brushes
   ///////////////
   auto wcbrush = FWorldCreatorBridgeStyle::Get().GetBrush("WorldCreatorBridge.WorldCreator");
@@ -855,16 +1028,67 @@ bool FWorldCreatorBridgeModule::CreateLandscape(int componentCountX, int compone
 }
 
 
+bool FWorldCreatorBridgeModule::IsSyncIdle() const
+{
+  return !syncJob.IsValid() || !syncJob->IsRunning();
+}
+
 FReply FWorldCreatorBridgeModule::SyncButtonClicked()
 {
 
 
+  // only one sync at a time, the running one can be cancelled from its notification
+  if (syncJob.IsValid() && syncJob->IsRunning())
+    return FReply::Handled();
+
   GEditor->GetSelectedActors()->DeselectAll();
   if (selectedPath.Len() <= 0)
     return FReply::Handled();
 
   FLevelEditorActionCallbacks::Save();
 
+  StartSync(GEditor->GetEditorWorldContext().World(), false);
+  return FReply::Handled();
+}
+
+void FWorldCreatorBridgeModule::ApplySyncSettings(const FWCSyncSettings& settings)
+{
+  selectedPath = settings.bridgeFilePath.Len() > 0 ? settings.bridgeFilePath : FWCSyncSettings::GetDefaultBridgeFilePath();
+  terrainName = settings.terrainName;
+  terrainMaterialName = settings.terrainMaterialName;
+  bImportTextures = settings.bImportTextures;
+  bImportLayers = settings.bImportLayers;
+  bUseWorldPartition = settings.bUseWorldPartition;
+  bBuildMinimap = settings.bBuildMinimap;
+  bStreamImport = settings.bStreamImport;
+  bIncrementalSync = settings.bIncrementalSync;
+  bUpdateInPlace = settings.bUpdateInPlace;
+  bPackLayerTextures = settings.bPackLayerTextures;
+  bLayerTextureArrays = settings.bLayerTextureArrays;
+  worldScale = settings.worldScale;
+  worldPartitionGridSize = settings.worldPartitionGridSize;
+  worldPartitionRegionSize = settings.worldPartitionRegionSize;
+  tileCacheBudgetMB = settings.tileCacheBudgetMB;
+  quatsPerSection = settings.quadsPerSection;
+  unrealTerrainResolution = settings.landscapeResolution;
+  UpdateTerrainResolution();
+  if (selectedPathBox.IsValid())
+    selectedPathBox->SetText(FText::FromString(selectedPath));
+}
+
+bool FWorldCreatorBridgeModule::RunSync(UWorld* world, const FWCSyncSettings& settings)
+{
+  if (world == nullptr || (syncJob.IsValid() && syncJob->IsRunning()))
+    return false;
+
+  ApplySyncSettings(settings);
+  return StartSync(world, true);
+}
+
+bool FWorldCreatorBridgeModule::StartSync(UWorld* world, bool bBlocking)
+{
+  const double startTime = FPlatformTime::Seconds();
+
   // set start values
   if (terrainName.Len() <= 0)
   {
@@ -876,8 +1100,6 @@ FReply FWorldCreatorBridgeModule::SyncButtonClicked()
   }
 
   // setup variables 
-  auto context = GEditor->GetEditorWorldContext();
-  auto world = context.World();
   auto level = world->GetCurrentLevel();
   float scaleFactor = SCALE_FACTOR * worldScale;
 
@@ -891,26 +1113,36 @@ FReply FWorldCreatorBridgeModule::SyncButtonClicked()
   }
 
   // import sync stuff
+  syncStats.Reset();
   if (!SetupXmlVariables())
   {
-    return FReply::Handled();
+    return false;
   }
 
 
 
+  // hashes of the previous sync, without them the whole terrain is imported
+  const FString syncStatePath = FWCSyncState::GetFilePath(FPaths::GetBaseFilename(world->GetOutermost()->GetName()), terrainName);
+  FWCSyncState previousSyncState;
+  const bool bHasPreviousSync = bIncrementalSync && previousSyncState.Load(syncStatePath);
+  FWCSyncState syncState;
+  if (!bIncrementalSync)
+  {
+    // a full sync does not hash the files, the state of an older sync no longer matches the landscapes
+    IFileManager::Get().Delete(*syncStatePath, false, false, true);
+  }
+
   if (bImportTextures)
-    ImportTextureFiles();
-  FXmlFile configFile(selectedPath);
-  root = configFile.GetRootNode();
-  if (root == NULL)
-    return FReply::Handled();
+    ImportTextureFiles(bHasPreviousSync ? &previousSyncState : nullptr, bIncrementalSync ? &syncState : nullptr);
+  else
+    syncState.textureHashes = previousSyncState.textureHashes;
 
-  FXmlNode* texturingNode = nullptr;
-  texturingNode = root->FindChildNode(TEXT("Texturing"));
-  if (texturingNode == nullptr)
+  if (!manifest->bHasTexturing)
   {
     bImportLayers = false;
   }
+  syncState.settingsHash = GetSyncSettingsHash();
+  const bool bFullSync = !bHasPreviousSync || previousSyncState.settingsHash != syncState.settingsHash;
 
   float m_scaleX = 100;
   float m_scaleY = 100;
@@ -924,334 +1156,821 @@ FReply FWorldCreatorBridgeModule::SyncButtonClicked()
   }
   else
   {
-    float height = XmlHelper::GetFloat(root->FindChildNode(TEXT("Surface")), "Height");
-    terrainScale = ((maxHeight - minHeight) * height) * UNREAL_TERRAIN_SCALE_FACTOR * rescaleFactor;
+    terrainScale = ((maxHeight - minHeight) * manifest->height) * UNREAL_TERRAIN_SCALE_FACTOR * rescaleFactor;
   }
 
     //// Load Heightmap & splatmap
     //////////////////////////////
 
-  int startX = 0;
-  int startY = 0;
-  int landscapeId = 0;
+  const TArray<FWCManifestSplatmap>& splatmaps = manifest->splatmaps;
+  const int numSplatChannels = manifest->GetNumLayers();
+  
+
+  tileCache.Empty();
+  tileCache.SetBudget((int64)tileCacheBudgetMB * 1024 * 1024);
+
+  //// Split the terrain into unreal landscapes
+  /////////////////////////////////////////////
   int heightDataWidth = width < unrealTerrainResolution ? width : unrealTerrainResolution;
   int heightDataLength = length < unrealTerrainResolution ? length : unrealTerrainResolution;
   heightDataWidth = RecaulculateToUnrealSize(quatsPerSection, heightDataWidth);
   heightDataLength = RecaulculateToUnrealSize(quatsPerSection, heightDataLength);
 
-
-  int lengthCopy = length;
-  int widthCopy = width;
-
-
-  TArray<FXmlNode*> splatmapNodes;
-  int numSplatChannels = 0;
-  if (texturingNode != nullptr)
+  if (version < 3)
   {
-    splatmapNodes = texturingNode->GetChildrenNodes();
-    for (FXmlNode* child : splatmapNodes)
+    // older versions store the whole terrain in one set of files, their size defines the remaining landscapes;
+    // the first landscape keeps the size computed above, as it did when the files were read while importing it
+    if (splatmaps.Num() > 0)
+    {
+      TSharedPtr<WCLandscapeTile> legacyTile = TileToData(0, 0, splatmaps);
+      if (legacyTile.IsValid())
+      {
+        width = legacyTile->width;
+        length = legacyTile->height;
+      }
+    }
+    else
     {
-      numSplatChannels += child->GetChildrenNodes().Num();
+      width = resX;
+      length = resY;
     }
   }
-  
-
-  // create vectors to save the base location and rotation and remove the previously imported terrain
-  FVector* location = new FVector(0, 0, 0);
-  FRotator* rotation = new FRotator(0, 0, 0);
-  DeletePreviousImportedWorldCreatorLandscape(world, location, rotation);
 
+  TArray<FWCUnrealTile> unrealTiles;
+  int startX = 0;
   for (int tileX = 0; tileX < unrealNumTilesX; tileX++)
   {
-
-    heightDataLength = length < unrealTerrainResolution ? length : unrealTerrainResolution;
-    startY = 0;
-    // originalHeightDataLength = heightDataLength;
-    heightDataLength = RecaulculateToUnrealSize(quatsPerSection, heightDataLength);
+    if (tileX > 0)
+    {
+      heightDataLength = length < unrealTerrainResolution ? length : unrealTerrainResolution;
+      heightDataLength = RecaulculateToUnrealSize(quatsPerSection, heightDataLength);
+    }
+    int startY = 0;
     for (int tileY = 0; tileY < unrealNumTilesY; tileY++)
     {
-      TArray<FLandscapeImportLayerInfo> layerInfos;
-      // reverse that in case of length reversal
-      location->Y = (startX * scaleX - tileX) * 100;
-      location->X = (startY * scaleY - tileY) * 100;
-
-      TArray<uint16> heightData;
-      UE_LOG(LogTemp, Log, TEXT("%d, %d"), heightDataWidth, heightDataLength);
-      heightData.Init(0, heightDataWidth * heightDataLength);
-      TArray<TArray<uint8>> splatData;
-      int numSplatmaps = bImportLayers ? numSplatChannels : 1;
-      int initSplatmapValue = bImportLayers ? 0 : 1;
-      splatData.Init(TArray<uint8>(), numSplatmaps);
-      for (int sp = 0; sp < splatData.Num(); sp++)
-      {
-        splatData[sp].Init(initSplatmapValue, heightDataWidth * heightDataLength);
-      }
-      // here i have to load in all maps, order y prioritized 
-      TArray<WCLandscapeTile> loadedTiles;
-
-      // the addition of UNREAL_MIN_TILE_RESOLUTION serves as a preventation of zero sized terrains 
-      int numLoadedXTiles = 1 + ((startX % WC_TILE_RESOLUTION + heightDataWidth) / (WC_TILE_RESOLUTION + UNREAL_MIN_TILE_RESOLUTION + 1));
-      int numLoadedYTiles = 1 + ((startY % WC_TILE_RESOLUTION + heightDataLength) / (WC_TILE_RESOLUTION + UNREAL_MIN_TILE_RESOLUTION + 1));
-
-      int startTileX = (startX / WC_TILE_RESOLUTION);
-      int startTileY = (startY / WC_TILE_RESOLUTION);
-
-      int constraintX = 0;
-      int constraintY = 0;
-      int mappingWidth, mappingLength;
-      int lengthLeft = heightDataLength;
-      int widthLeft = heightDataWidth;
-      int tmpStartX, tmpStartY;
-      int heightStartX = 0;
-      int heightStartY = 0;
-      if (version >= 3)
-      {
-        tmpStartX = startX % WC_TILE_RESOLUTION;
-        tmpStartY = startY % WC_TILE_RESOLUTION;
-      }
-      else
-      {
-        tmpStartX = startX;
-        tmpStartY = startY;
-      }
-
-      for (int x = 0; x < numLoadedXTiles; x++)
-      {
-        lengthLeft = heightDataLength;
-        heightStartY = 0;
-        for (int y = 0; y < numLoadedYTiles; y++)
-        {
-          FString pathEnding = FString::Printf(TEXT("_%d_%d"), startTileX + x, startTileY + y);
-          // loadedTiles.Add(TileToData(pathEnding, splatmapNodes));
-
-          WCLandscapeTile* tile = TileToData(pathEnding, splatmapNodes);
-          //FString heightmapFileName = GetHeightmapPath(syncDir, pathEnding, version, HEIGHTMAP_FILEENDING);
-          if (tile == nullptr)
-          {
-            continue;
-          }
-
-          uint16* currentHeightMap = (uint16*)tile->heightmap.GetData();
-          mappingWidth = tile->width;
-          mappingLength = tile->height;
-
-          int xLeftOnTile = mappingWidth - tmpStartX;
-          int yLeftOnTile = mappingLength - tmpStartY;
-          constraintX = xLeftOnTile < widthLeft ? xLeftOnTile : widthLeft;
-          constraintY = yLeftOnTile < lengthLeft ? yLeftOnTile : lengthLeft;
-          for (int y2 = 0; y2 < constraintY; y2++)
-          {
-            for (int x2 = 0; x2 < constraintX; x2++)
-            {
-              int extractX = x2 + tmpStartX;
-              int extractY = y2 + tmpStartY;
-              int heightX = x2 + heightStartX;
-              int heightY = y2 + heightStartY;
-
-              int extractIdx = 0;
-              if (version >= 3)
-              {
-                extractIdx = (mappingLength * mappingWidth - 1) - ((mappingWidth - extractX - 1) + extractY * mappingWidth);
-              }
-              else
-              {
-                extractIdx = (extractX + (extractY)*mappingWidth);
-              }
-
-              int insertIdx = 0;
-              insertIdx = heightX * heightDataLength + heightY;// this hole thing is a idear for optimization
-
-              heightData[insertIdx] = currentHeightMap[extractIdx];
-
-              if (bImportLayers)
-              {
-                for (int j = 0; j < tile->splatmaps.Num(); j++)
-                {
-                  uint8* fileData = tile->splatmaps[j].GetData();
-                  FXmlNode* curretnSplatMap = splatmapNodes[j];
-                  int multV = multV = ((extractX)+extractY * mappingWidth) * tile->Bpp;
-                  // int multV = ((currentTile.width * currentTile.height) - ((currentTile.height - 1 - extractY) * currentTile.width + extractX) - 1) * currentTile.Bpp;
-                  int numCurrentSplatChilds = curretnSplatMap->GetChildrenNodes().Num();
-
-                  for (int k = 0; k < numCurrentSplatChilds; k++)
-                  {
-                    int cuurentDataMapIdx = j * 4 + k;
-                    uint8* currentDataMap = splatData[cuurentDataMapIdx].GetData();
-                    switch (k)
-                    {
-                    case 0:
-                      currentDataMap[insertIdx] = (fileData)[multV + 2];
-                      break;
-                    case 1:
-                      currentDataMap[insertIdx] = (fileData)[multV + 1];
-                      break;
-                    case 2:
-                      currentDataMap[insertIdx] = (fileData)[multV];
-                      break;
-                    case 3:
-                      currentDataMap[insertIdx] = (fileData)[multV + 3];
-                      break;
-                    }
-                  }
-                }
-              }
-            }
-          }
-          lengthLeft -= constraintY;
-          heightStartY += constraintY;
-          tmpStartY = 0;
-        }
-        widthLeft -= constraintX;
-        heightStartX += constraintX;
-        tmpStartX = 0;
-        tmpStartY = startY % WC_TILE_RESOLUTION;
-      }
-      int mapIdx = 0;
-      TSharedPtr<LandscapeImportData> data = MakeShared<LandscapeImportData>();
-      for (int i = 0; i < splatData.Num(); i++)
-      {
-        FString tmpPath = FString::Printf(TEXT("%s%s_layerinfo_%d_%d_%d"), MATERIAL_PACKAGE_NAME_PREFIX.GetCharArray().GetData(), terrainName.GetCharArray().GetData(), i, tileX, tileY);
-        FSoftObjectPath tmpSoftPath(tmpPath);
-        ULandscapeLayerInfoObject* tmpLI = Cast<ULandscapeLayerInfoObject>(tmpSoftPath.TryLoad());
-        if (tmpLI != nullptr)
-        {
-          ObjectTools::DeleteSingleObject(tmpLI);
-        }
-        UPackage* infoPackage = CreatePackage(*tmpPath);
-        FName LayerObjectName = FName(*FString::Printf(TEXT("%s_layerinfo_%d_%d_%d"), terrainName.GetCharArray().GetData(), i, tileX, tileY));
-
-        ULandscapeLayerInfoObject* layerInfoObject = NewObject<ULandscapeLayerInfoObject>(infoPackage, LayerObjectName, RF_Public | RF_Standalone | RF_Transactional);
-        FLandscapeImportLayerInfo layerInfo;
-        FString layerInfoNameString = XmlHelper::GetString(splatmapNodes[i / 4]->GetChildrenNodes()[i % 4], "Name");
-        FName layerInfoName = FName(*FString::Printf(TEXT("%d: %s"), i, layerInfoNameString.GetCharArray().GetData()));
-        layerInfo.LayerData = splatData[i];
-        layerInfo.LayerName = layerInfoName;// FString::Printf(TEXT("Texture%d"), i).GetCharArray().GetData();//FName(FString::Printf(TEXT("%s"), textures[i]->GetAttribute("Name").GetCharArray().GetData()).GetCharArray().GetData());
-
-        layerInfo.LayerInfo = layerInfoObject;
-        layerInfo.LayerInfo->bNoWeightBlend = 0;
-        layerInfo.LayerInfo->Hardness = 1;
-        layerInfo.LayerInfo->IsReferencedFromLoadedData = false;
-        layerInfo.LayerInfo->LayerName = layerInfo.LayerName;
-        layerInfos.Add(layerInfo);
-
-        infoPackage->FullyLoad();
-        infoPackage->SetDirtyFlag(true);
-        FAssetRegistryModule::AssetCreated(layerInfoObject);
-
-      }
-      data->material = CreateLandscapeMaterial(landscapeId, numLoadedXTiles, numLoadedYTiles, startX, startY, mappingWidth, mappingLength);
-      //data->material = CreateLandscapeMaterial(landscapeId, numLoadedXTiles, numLoadedYTiles, startX, startY, currentTile.width, currentTile.height);
-      data->heightData = heightData;
-      data->scaleX = m_scaleX;
-      data->scaleY = m_scaleY;
-      data->terrainScale = terrainScale;
-      //data.material = nullptr; // TODO remove for mat
-      data->layerInfos = layerInfos;
-      data->quatsPerSection = quatsPerSection;
-      ImportHeightMapToLandscape(world, data, heightDataLength, heightDataWidth, landscapeId, *location, *rotation);
-      landscapeId++;
+      FWCUnrealTile& unrealTile = unrealTiles.AddDefaulted_GetRef();
+      unrealTile.tileX = tileX;
+      unrealTile.tileY = tileY;
+      unrealTile.landscapeId = unrealTiles.Num() - 1;
+      unrealTile.startX = startX;
+      unrealTile.startY = startY;
+      unrealTile.heightDataWidth = heightDataWidth;
+      unrealTile.heightDataLength = heightDataLength;
 
       startY += heightDataLength;
       int tmpLength = length - (tileY + 1) * unrealTerrainResolution;
       heightDataLength = tmpLength < unrealTerrainResolution ? tmpLength : unrealTerrainResolution;
-
-      // originalHeightDataLength = heightDataLength;
       heightDataLength = RecaulculateToUnrealSize(quatsPerSection, heightDataLength);
     }
 
-    startY = 0;
     startX += heightDataWidth;
     int tmpWidth = width - (tileX + 1) * unrealTerrainResolution;
     heightDataWidth = tmpWidth < unrealTerrainResolution ? tmpWidth : unrealTerrainResolution;
-    // originalHeightDataWidth = heightDataWidth;
     heightDataWidth = RecaulculateToUnrealSize(quatsPerSection, heightDataWidth);
   }
 
-
-  if (bBuildMinimap)// && bUseWorldPartition) // TODO fix it. try running it on a seperate frame or try running it with allowing unreal to run in between 
+  TSharedRef<FWCSyncContext> syncContext = MakeShared<FWCSyncContext>();
+  syncContext->world = world;
+  syncContext->manifest = manifest;
+  syncContext->syncStatePath = syncStatePath;
+  syncContext->startTime = startTime;
+  syncContext->numUnrealTiles = unrealTiles.Num();
+  syncContext->numSplatChannels = numSplatChannels;
+  syncContext->scaleX = m_scaleX;
+  syncContext->scaleY = m_scaleY;
+  syncContext->terrainScale = terrainScale;
+  syncContext->layoutTiles = MoveTemp(unrealTiles);
+  syncContext->syncState = MoveTemp(syncState);
+  syncContext->bFullSync = bFullSync;
+  if (!bFullSync)
+    syncContext->previousSyncState = MoveTemp(previousSyncState);
+
+  syncJob = MakeShared<FWCSyncJob>(FText::Format(LOCTEXT("SyncJobTitle", "World Creator Sync of {0}"), FText::FromString(terrainName)));
+
+  //// Compare with the previous sync
+  ////////////////////////////////////
+  if (bIncrementalSync)
+  {
+    // the tile files are hashed one batch per step, hashing is bound by reading them. The landscapes to update
+    // and import are only known after the last batch, their stages are added by the final step
+    PlanTileHashes(*syncContext);
+    const int batchSize = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+    const int numBatches = FMath::DivideAndRoundUp(syncContext->tileKeys.Num(), batchSize);
+    syncJob->AddStage(LOCTEXT("CompareStage", "Comparing with the previous sync"), numBatches + 1, [this, syncContext, batchSize, numBatches](int step)
+      {
+        if (!syncContext->world.IsValid())
+          return false;
+        if (step < numBatches)
+        {
+          HashTiles(*syncContext, step * batchSize, batchSize);
+          return true;
+        }
+        AddImportStages(syncContext, FindChangedLandscapes(*syncContext));
+        syncContext->bSaveSyncState = true;
+        return true;
+      });
+  }
+  else
   {
-    FEditorBuildUtils::EditorBuild(world, FBuildOptions::BuildMinimap);
-    //FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("World Creator Sync", "Due to a current bug in the building of a minimap via code the building on the minimap cannot currently be handled by the World Creator Bridge tools syncronization. Please use the button below to Build the minimap for your project"));
+    // without the previous sync every landscape is imported
+    TSet<int> changedLandscapes;
+    for (const FWCUnrealTile& unrealTile : syncContext->layoutTiles)
+    {
+      changedLandscapes.Add(unrealTile.landscapeId);
+    }
+    AddImportStages(syncContext, changedLandscapes);
   }
 
-  //    // Cleanup memory  
-   //    ////////////////
-  configFile.Clear();
-  return FReply::Handled();
+  FWCSyncJob::FFinishFunction finishFunction = [this, syncContext](bool bCompleted)
+    {
+      FinishSync(*syncContext, bCompleted);
+    };
+  if (bBlocking)
+    return syncJob->Run(MoveTemp(finishFunction));
+
+  syncJob->Start(MoveTemp(finishFunction));
+  return true;
 }
 
-WCLandscapeTile* FWorldCreatorBridgeModule::TileToData(FString pathEnding, TArray<FXmlNode*> texturNodes)
+void FWorldCreatorBridgeModule::AddImportStages(const TSharedRef<FWCSyncContext>& syncContext, TSet<int> changedLandscapes)
 {
-  TArray<TArray<uint8>> splatmaps;
-  TArray<uint8> heightmap;
-  WCLandscapeTile* tile = new WCLandscapeTile();
-  for (int i = 0; i < texturNodes.Num(); i++)
+  UWorld* world = syncContext->world.Get();
+  syncContext->pendingLandscapes = changedLandscapes;
+
+  // with an unchanged layout the existing landscapes get the new data written into their dirty rects,
+  // only the landscapes that cannot be updated are deleted and imported again
+  if (!syncContext->bFullSync && bUpdateInPlace)
   {
-    FXmlNode* child = texturNodes[i];
-    int splatmapIndex = XmlHelper::GetInt(child, "Index");
-    splatmapIndex = FMath::Max(0, splatmapIndex);
-    FString filePath;
-    if (version >= 3 && splatmapIndex >= 0) // THE && condition can be removed in future versions, it is a temporary solution for the 1.1 version (2023.1.1b) of the beta
+    const TMap<int, ALandscape*> existingLandscapes = FindImportedLandscapes(world);
+    for (const FWCUnrealTile& unrealTile : syncContext->layoutTiles)
     {
-      filePath = FString::Printf(TEXT("%s/splatmap_%d%s.%s"), syncDir.GetCharArray().GetData(), splatmapIndex, pathEnding.GetCharArray().GetData(), SPLATMAP_FILEENDING);
+      ALandscape* const* landscapeActor = existingLandscapes.Find(unrealTile.landscapeId);
+      if (landscapeActor != nullptr && changedLandscapes.Contains(unrealTile.landscapeId) && CanUpdateLandscapeInPlace(*landscapeActor, unrealTile, syncContext->numSplatChannels))
+      {
+        changedLandscapes.Remove(unrealTile.landscapeId);
+        syncContext->updateTiles.Add(unrealTile);
+      }
     }
-    else
+  }
+
+  for (const FWCUnrealTile& unrealTile : syncContext->layoutTiles)
+  {
+    if (changedLandscapes.Contains(unrealTile.landscapeId))
+      syncContext->unrealTiles.Add(unrealTile);
+  }
+  UE_LOG(LogTemp, Log, TEXT("Importing %d and updating %d of %d landscapes of %s"), syncContext->unrealTiles.Num(), syncContext->updateTiles.Num(), syncContext->numUnrealTiles, *terrainName);
+
+  // remove the previously imported terrain, the base location and rotation are taken over by the new one
+  DeletePreviousImportedWorldCreatorLandscape(world, &syncContext->location, &syncContext->rotation, syncContext->bFullSync ? nullptr : &changedLandscapes);
+
+  //// Import the landscapes
+  //////////////////////////
+  // reading and assembling the upcoming landscapes runs on worker threads while the current one is imported,
+  // only the creation of the unreal objects stays on the game thread, one landscape per step of the sync job.
+  // Streamed imports assemble their regions themselves.
+  // the dirty rects of the updated landscapes are assembled ahead the same way
+  syncContext->updateTasks.Reserve(syncContext->updateTiles.Num());
+  for (int i = 0; i < FMath::Min(syncContext->updateTiles.Num(), ASSEMBLE_PIPELINE_DEPTH); i++)
+  {
+    LaunchUpdateAssembleTask(*syncContext);
+  }
+  syncContext->assembleTasks.Reserve(syncContext->unrealTiles.Num());
+  if (!bStreamImport)
+  {
+    for (int i = 0; i < FMath::Min(syncContext->unrealTiles.Num(), ASSEMBLE_PIPELINE_DEPTH); i++)
     {
-      FString fileName = XmlHelper::GetString(child, "Name");
-      filePath = FString::Printf(TEXT("%s/%s"), syncDir.GetCharArray().GetData(), fileName.GetCharArray().GetData());
+      LaunchAssembleTask(*syncContext);
     }
+  }
 
-    int fileWidth, fileHeight, fileBpp;
-    TArray<uint8> fileData;
+  syncJob->AddStage(LOCTEXT("UpdateStage", "Updating landscapes"), syncContext->updateTiles.Num(), [this, syncContext](int step)
+    {
+      if (!syncContext->world.IsValid())
+        return false;
+      const FWCUnrealTile& unrealTile = syncContext->updateTiles[step];
+      TSharedPtr<FWCAssembledTile> region = syncContext->updateTasks[step].GetResult();
+      syncContext->updateTasks[step] = {};
+      if (syncContext->updateTasks.Num() < syncContext->updateTiles.Num())
+      {
+        LaunchUpdateAssembleTask(*syncContext);
+      }
 
-    FFileHelper::LoadFileToArray(fileData, filePath.GetCharArray().GetData());
+      const TMap<int, ALandscape*> existingLandscapes = FindImportedLandscapes(syncContext->world.Get());
+      ALandscape* const* landscapeActor = existingLandscapes.Find(unrealTile.landscapeId);
+      if (landscapeActor == nullptr || !UpdateLandscapeInPlace(*landscapeActor, unrealTile, syncContext->dirtyRects[unrealTile.landscapeId], *region, syncContext->numSplatChannels))
+      {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to update landscape %d of %s"), unrealTile.landscapeId, *terrainName);
+        return true;
+      }
+      syncContext->pendingLandscapes.Remove(unrealTile.landscapeId);
+      return true;
+    });
+  syncJob->AddStage(LOCTEXT("ImportStage", "Importing landscapes"), syncContext->unrealTiles.Num(), [this, syncContext](int step)
+    {
+      if (!syncContext->world.IsValid())
+        return false;
+      ImportUnrealTile(*syncContext, step);
+      syncContext->pendingLandscapes.Remove(syncContext->unrealTiles[step].landscapeId);
+      return true;
+    });
+  if (bBuildMinimap)// && bUseWorldPartition) // TODO fix it. try running it on a seperate frame or try running it with allowing unreal to run in between 
+  {
+    syncJob->AddStage(LOCTEXT("MinimapStage", "Building minimap"), 1, [syncContext](int step)
+      {
+        if (!syncContext->world.IsValid())
+          return false;
+        FEditorBuildUtils::EditorBuild(syncContext->world.Get(), FBuildOptions::BuildMinimap);
+        //FMessageDialog::Open(EAppMsgType::Ok, LOCTEXT("World Creator Sync", "Due to a current bug in the building of a minimap via code the building on the minimap cannot currently be handled by the World Creator Bridge tools syncronization. Please use the button below to Build the minimap for your project"));
+        return true;
+      });
+  }
+}
 
-    uint8* dataPtr = (fileData).GetData();
-    if (dataPtr == nullptr)
+void FWorldCreatorBridgeModule::LaunchAssembleTask(FWCSyncContext& syncContext)
+{
+  const FWCUnrealTile unrealTile = syncContext.unrealTiles[syncContext.assembleTasks.Num()];
+  const TSharedPtr<const FWCSyncManifest> syncManifest = syncContext.manifest;
+  const int numSplatChannels = syncContext.numSplatChannels;
+  syncContext.assembleTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, unrealTile, syncManifest, numSplatChannels]()
     {
-      return nullptr;
-    }
+      return AssembleUnrealTile(unrealTile, syncManifest->splatmaps, numSplatChannels);
+    }));
+}
 
-    fileWidth = *(short*)(&dataPtr[12]);
-    fileHeight = *(short*)(&dataPtr[14]);
-    fileBpp = (*(uint8*)(&dataPtr[16])) / 8;
-    if (i == 0)
+void FWorldCreatorBridgeModule::LaunchUpdateAssembleTask(FWCSyncContext& syncContext)
+{
+  // only the rows of the dirty rect are assembled, like a region of a streamed import
+  const FWCUnrealTile unrealTile = syncContext.updateTiles[syncContext.updateTasks.Num()];
+  const FIntRect dirtyRect = syncContext.dirtyRects[unrealTile.landscapeId];
+  const TSharedPtr<const FWCSyncManifest> syncManifest = syncContext.manifest;
+  const int numSplatChannels = syncContext.numSplatChannels;
+  syncContext.updateTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, unrealTile, dirtyRect, syncManifest, numSplatChannels]()
     {
-      tile->height = fileHeight;
-      tile->width = fileWidth;
-      tile->Bpp = fileBpp;
-    }
-    (fileData).RemoveAt(0, 18);
-    splatmaps.Add(fileData);
-  }
-  tile->splatmaps = splatmaps;
+      return AssembleUnrealTile(unrealTile, syncManifest->splatmaps, numSplatChannels, dirtyRect.Min.X, dirtyRect.Width());
+    }));
+}
 
-  FString heightmapPath;
-  if (version >= 3)
+void FWorldCreatorBridgeModule::ImportUnrealTile(FWCSyncContext& syncContext, int tileIndex)
+{
+  UWorld* world = syncContext.world.Get();
+  const TArray<FWCManifestSplatmap>& splatmaps = syncContext.manifest->splatmaps;
+  const int numSplatChannels = syncContext.numSplatChannels;
+  FVector* location = &syncContext.location;
+  FRotator* rotation = &syncContext.rotation;
+
+  const FWCUnrealTile& unrealTile = syncContext.unrealTiles[tileIndex];
+  TSharedPtr<FWCAssembledTile> assembledTile;
+  if (bStreamImport)
   {
-    heightmapPath = FString::Printf(TEXT("%s/heightmap%s.%s"), syncDir.GetCharArray().GetData(), pathEnding.GetCharArray().GetData(), &HEIGHTMAP_FILEENDING);
+    // the material only needs the layout of the tiles, the data is assembled later region by region
+    assembledTile = MakeShared<FWCAssembledTile>();
+    TArray<FWCBlitPlanEntry> plan;
+    BuildBlitPlan(unrealTile.startX, unrealTile.startY, unrealTile.heightDataWidth, unrealTile.heightDataLength, plan);
+    GetPlanLayout(plan, splatmaps, nullptr, *assembledTile);
   }
   else
   {
-    heightmapPath = FString::Printf(TEXT("%s/heightmap.%s"), syncDir.GetCharArray().GetData(), &HEIGHTMAP_FILEENDING);
-    if (texturNodes.Num() > 0)
+    assembledTile = syncContext.assembleTasks[tileIndex].GetResult();
+    syncContext.assembleTasks[tileIndex] = {};
+    if (syncContext.assembleTasks.Num() < syncContext.unrealTiles.Num())
     {
-      width = tile->width;
-      length = tile->height;
+      LaunchAssembleTask(syncContext);
     }
-    else
-    {
-      width = resX;
-      length = resY;
-      tile->width = width;
-      tile->height = length;
+  }
+
+  const int tileX = unrealTile.tileX;
+  const int tileY = unrealTile.tileY;
+  const int landscapeId = unrealTile.landscapeId;
+
+  // reverse that in case of length reversal
+  location->Y = (unrealTile.startX * scaleX - tileX) * 100;
+  location->X = (unrealTile.startY * scaleY - tileY) * 100;
+
+  TSharedPtr<LandscapeImportData> data = MakeShared<LandscapeImportData>();
+  TArray<FLandscapeImportLayerInfo> layerInfos;
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(FWorldCreatorBridgeModule::CreateLayerInfos);
+    FWCSyncStats::FScopedStage stage(syncStats, EWCSyncStage::LayerInfo);
+    layerInfos = CreateLayerInfos(unrealTile, bImportLayers ? numSplatChannels : 1, splatmaps);
+  }
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(FWorldCreatorBridgeModule::CreateLandscapeMaterial);
+    FWCSyncStats::FScopedStage stage(syncStats, EWCSyncStage::Material);
+    data->material = CreateLandscapeMaterial(landscapeId, assembledTile->numLoadedXTiles, assembledTile->numLoadedYTiles, unrealTile.startX, unrealTile.startY, assembledTile->mappingWidth, assembledTile->mappingLength);
+  }
+  //data->material = CreateLandscapeMaterial(landscapeId, numLoadedXTiles, numLoadedYTiles, startX, startY, currentTile.width, currentTile.height);
+  data->scaleX = syncContext.scaleX;
+  data->scaleY = syncContext.scaleY;
+  data->terrainScale = syncContext.terrainScale;
+  //data.material = nullptr; // TODO remove for mat
+  data->quatsPerSection = quatsPerSection;
+
+  // the streamed import assembles its regions while importing, their time is counted for both stages
+  const int64 landscapeBytes = (int64)unrealTile.heightDataWidth * unrealTile.heightDataLength * (sizeof(uint16) + layerInfos.Num());
+  TRACE_CPUPROFILER_EVENT_SCOPE(FWorldCreatorBridgeModule::ImportLandscape);
+  FWCSyncStats::FScopedStage stage(syncStats, EWCSyncStage::LandscapeImport, landscapeBytes);
+  if (bStreamImport)
+  {
+    data->layerInfos = MoveTemp(layerInfos);
+    ImportStreamedLandscape(world, data, unrealTile, splatmaps, numSplatChannels, *location, *rotation);
+  }
+  else
+  {
+    // the assembled buffers are handed on, the tile is not used after the import
+    for (int i = 0; i < layerInfos.Num(); i++)
+    {
+      layerInfos[i].LayerData = MoveTemp(assembledTile->splatData[i]);
+    }
+    data->heightData = MoveTemp(assembledTile->heightData);
+    data->layerInfos = MoveTemp(layerInfos);
+    ImportHeightMapToLandscape(world, data, unrealTile.heightDataLength, unrealTile.heightDataWidth, landscapeId, *location, *rotation);
+    assembledTile.Reset();
+  }
+}
+
+void FWorldCreatorBridgeModule::WriteImportReport(const FWCSyncContext& syncContext, bool bCompleted) const
+{
+  FWCImportReport report;
+  report.timestamp = FDateTime::Now();
+  TSharedPtr<IPlugin> plugin = IPluginManager::Get().FindPlugin(TEXT("WorldCreatorBridge"));
+  if (plugin.IsValid())
+    report.pluginVersion = plugin->GetDescriptor().VersionName;
+  if (syncContext.world.IsValid())
+    report.mapName = syncContext.world->GetOutermost()->GetName();
+  report.terrainName = terrainName;
+  report.bCompleted = bCompleted;
+  report.totalSeconds = FPlatformTime::Seconds() - syncContext.startTime;
+
+  const FWCSyncManifest& syncManifest = *syncContext.manifest;
+  report.manifestVersion = syncManifest.version;
+  report.resolutionX = syncManifest.resolutionX;
+  report.resolutionY = syncManifest.resolutionY;
+  report.tilesX = syncManifest.tilesX;
+  report.tilesY = syncManifest.tilesY;
+  report.tileResolution = tileResolution;
+  report.numLayers = syncManifest.GetNumLayers();
+
+  report.numUnrealTiles = syncContext.numUnrealTiles;
+  report.numImported = syncContext.unrealTiles.Num();
+  report.numUpdated = syncContext.updateTiles.Num();
+  report.quadsPerSection = quatsPerSection;
+  report.bImportLayers = bImportLayers;
+  report.bStreamImport = bStreamImport;
+  report.bUseWorldPartition = bUseWorldPartition;
+  report.bIncrementalSync = bIncrementalSync;
+  report.bPackLayerTextures = bPackLayerTextures;
+  report.bLayerTextureArrays = bLayerTextureArrays;
+  report.SetStats(syncStats);
+
+  const FString reportPath = FWCImportReport::GetFilePath(report.timestamp);
+  if (!report.Save(reportPath))
+  {
+    UE_LOG(LogTemp, Warning, TEXT("Failed to save the import report %s"), *reportPath);
+  }
+}
+
+void FWorldCreatorBridgeModule::FinishSync(FWCSyncContext& syncContext, bool bCompleted)
+{
+  // assembly tasks that were started ahead still read the tile cache
+  for (TArray<UE::Tasks::TTask<TSharedPtr<FWCAssembledTile>>>* tasks : { &syncContext.updateTasks, &syncContext.assembleTasks })
+  {
+    for (UE::Tasks::TTask<TSharedPtr<FWCAssembledTile>>& assembleTask : *tasks)
+    {
+      if (assembleTask.IsValid())
+        assembleTask.Wait();
+    }
+    tasks->Empty();
+  }
+
+  // only the landscapes that were imported keep their hashes, the ones a cancelled sync did not get to are
+  // treated as changed by the next one; their tiles lose their hashes too, so an in place update of them
+  // writes every tile and not only the ones that change again
+  for (const TArray<FWCUnrealTile>* tiles : { &syncContext.unrealTiles, &syncContext.updateTiles })
+  {
+    for (const FWCUnrealTile& unrealTile : *tiles)
+    {
+      if (!syncContext.pendingLandscapes.Contains(unrealTile.landscapeId))
+        continue;
+      syncContext.syncState.landscapeHashes.Remove(unrealTile.landscapeId);
+      TArray<FWCBlitPlanEntry> plan;
+      BuildBlitPlan(unrealTile.startX, unrealTile.startY, unrealTile.heightDataWidth, unrealTile.heightDataLength, plan);
+      for (const FWCBlitPlanEntry& entry : plan)
+      {
+        syncContext.syncState.tileHashes.Remove(entry.tileKey);
+      }
+    }
+  }
+
+  syncStats.Log(terrainName);
+  WriteImportReport(syncContext, bCompleted);
+  if (syncContext.bSaveSyncState && !syncContext.syncState.Save(syncContext.syncStatePath))
+  {
+    UE_LOG(LogTemp, Warning, TEXT("Failed to save the sync state %s"), *syncContext.syncStatePath);
+  }
+  if (!bCompleted)
+  {
+    UE_LOG(LogTemp, Warning, TEXT("Sync of %s was cancelled, %d landscapes were not imported"), *terrainName, syncContext.pendingLandscapes.Num());
+  }
+
+  if (bRefreshLandscapeMaterials)
+    RefreshLandscapeMaterials(syncContext.world.Get());
+
+  //    // Cleanup memory  
+   //    ////////////////
+  tileCache.Empty();
+  manifest.Reset();
+  parentMaterial.Reset();
+  colormapArray.Reset();
+  parentMaterialSlots = FIntPoint::ZeroValue;
+  bRefreshLandscapeMaterials = false;
+  if (GEditor)
+    GEditor->RedrawLevelEditingViewports();
+}
+
+void FWorldCreatorBridgeModule::RefreshLandscapeMaterials(UWorld* world)
+{
+  // only the components of landscapes that use the replaced material, instead of reregistering every component
+  UMaterial* material = parentMaterial.Get();
+  if (world == nullptr || material == nullptr)
+    return;
+
+  for (TActorIterator<ALandscapeProxy> it(world); it; ++it)
+  {
+    UMaterialInterface* landscapeMaterial = it->GetLandscapeMaterial();
+    if (landscapeMaterial != nullptr && landscapeMaterial->GetMaterial() == material)
+      it->UpdateAllComponentMaterialInstances();
+  }
+}
+
+TArray<FLandscapeImportLayerInfo> FWorldCreatorBridgeModule::CreateLayerInfos(const FWCUnrealTile& unrealTile, int numLayers, const TArray<FWCManifestSplatmap>& splatmaps)
+{
+  const int tileX = unrealTile.tileX;
+  const int tileY = unrealTile.tileY;
+  TArray<FLandscapeImportLayerInfo> layerInfos;
+  for (int i = 0; i < numLayers; i++)
+  {
+    FString tmpPath = MATERIAL_PACKAGE_NAME_PREFIX + GetLayerInfoName(i, unrealTile);
+    FSoftObjectPath tmpSoftPath(tmpPath);
+    ULandscapeLayerInfoObject* tmpLI = Cast<ULandscapeLayerInfoObject>(tmpSoftPath.TryLoad());
+    if (tmpLI != nullptr)
+    {
+      ObjectTools::DeleteSingleObject(tmpLI);
+    }
+    UPackage* infoPackage = CreatePackage(*tmpPath);
+    FName LayerObjectName = FName(*GetLayerInfoName(i, unrealTile));
+
+    ULandscapeLayerInfoObject* layerInfoObject = NewObject<ULandscapeLayerInfoObject>(infoPackage, LayerObjectName, RF_Public | RF_Standalone | RF_Transactional);
+    FLandscapeImportLayerInfo layerInfo;
+    const FString& layerInfoNameString = splatmaps[i / 4].layers[i % 4].name;
+    FName layerInfoName = FName(*FString::Printf(TEXT("%d: %s"), i, layerInfoNameString.GetCharArray().GetData()));
+    layerInfo.LayerName = layerInfoName;// FString::Printf(TEXT("Texture%d"), i).GetCharArray().GetData();//FName(FString::Printf(TEXT("%s"), textures[i]->GetAttribute("Name").GetCharArray().GetData()).GetCharArray().GetData());
+
+    layerInfo.LayerInfo = layerInfoObject;
+    layerInfo.LayerInfo->bNoWeightBlend = 0;
+    layerInfo.LayerInfo->Hardness = 1;
+    layerInfo.LayerInfo->IsReferencedFromLoadedData = false;
+    layerInfo.LayerInfo->LayerName = layerInfo.LayerName;
+    layerInfos.Add(layerInfo);
+
+    infoPackage->FullyLoad();
+    infoPackage->SetDirtyFlag(true);
+    FAssetRegistryModule::AssetCreated(layerInfoObject);
+  }
+  return layerInfos;
+}
+
+bool FWorldCreatorBridgeModule::LoadLayerInfos(const FWCUnrealTile& unrealTile, int numLayers, TArray<FLandscapeImportLayerInfo>& outLayerInfos)
+{
+  // the layer infos of the previous import, an update writes into the same layers
+  for (int i = 0; i < numLayers; i++)
+  {
+    FSoftObjectPath layerInfoPath(MATERIAL_PACKAGE_NAME_PREFIX + GetLayerInfoName(i, unrealTile));
+    ULandscapeLayerInfoObject* layerInfoObject = Cast<ULandscapeLayerInfoObject>(layerInfoPath.TryLoad());
+    if (layerInfoObject == nullptr)
+      return false;
+
+    FLandscapeImportLayerInfo& layerInfo = outLayerInfos.AddDefaulted_GetRef();
+    layerInfo.LayerName = layerInfoObject->LayerName;
+    layerInfo.LayerInfo = layerInfoObject;
+  }
+  return true;
+}
+
+FString FWorldCreatorBridgeModule::GetLayerInfoName(int layerIndex, const FWCUnrealTile& unrealTile) const
+{
+  return FString::Printf(TEXT("%s_layerinfo_%d_%d_%d"), terrainName.GetCharArray().GetData(), layerIndex, unrealTile.tileX, unrealTile.tileY);
+}
+
+void FWorldCreatorBridgeModule::BuildBlitPlan(int startX, int startY, int destWidth, int destLength, TArray<FWCBlitPlanEntry>& outPlan) const
+{
+  // version 3 splits the terrain into tiles of the manifest's TileResolution, older versions use one set of files
+  if (version >= 3)
+  {
+    FWCTileAssembly::BuildPlan(startX, startY, destWidth, destLength, tileResolution, tileResolution, width, length, outPlan);
+  }
+  else
+  {
+    FWCTileAssembly::BuildPlan(startX, startY, destWidth, destLength, width, length, width, length, outPlan);
+  }
+}
+
+void FWorldCreatorBridgeModule::LoadPlanTiles(const TArray<FWCBlitPlanEntry>& plan, const TArray<FWCManifestSplatmap>& splatmaps, TMap<FIntPoint, TSharedPtr<WCLandscapeTile>>& outTiles, FWCAssembledTile& outTile)
+{
+  // the tiles are loaded up front, the same tile is shared by all strips that are copied from it
+  for (const FWCBlitPlanEntry& entry : plan)
+  {
+    if (!outTiles.Contains(entry.tileKey))
+      outTiles.Add(entry.tileKey, TileToData(entry.tileKey.X, entry.tileKey.Y, splatmaps));
+  }
+  GetPlanLayout(plan, splatmaps, &outTiles, outTile);
+}
+
+void FWorldCreatorBridgeModule::GetPlanLayout(const TArray<FWCBlitPlanEntry>& plan, const TArray<FWCManifestSplatmap>& splatmaps, const TMap<FIntPoint, TSharedPtr<WCLandscapeTile>>* loadedTiles, FWCAssembledTile& outTile) const
+{
+  // number of tiles the landscape covers and the size of the last one. Without loaded tiles the size is read from
+  // the header of the first splatmap, so a streamed import does not decode the tiles twice
+  TSet<FIntPoint> tileKeys;
+  TSet<int> loadedTilesX;
+  TSet<int> loadedTilesY;
+  outTile.mappingWidth = tileResolution;
+  outTile.mappingLength = tileResolution;
+  for (const FWCBlitPlanEntry& entry : plan)
+  {
+    bool bAlreadyInSet;
+    tileKeys.Add(entry.tileKey, &bAlreadyInSet);
+    if (bAlreadyInSet)
+      continue;
+    loadedTilesX.Add(entry.tileKey.X);
+    loadedTilesY.Add(entry.tileKey.Y);
+
+    FWCTgaHeader header;
+    if (loadedTiles != nullptr)
+    {
+      const TSharedPtr<WCLandscapeTile> tile = loadedTiles->FindRef(entry.tileKey);
+      if (tile.IsValid() && tile->width > 0)
+      {
+        outTile.mappingWidth = tile->width;
+        outTile.mappingLength = tile->height;
+      }
+    }
+    else if (splatmaps.Num() > 0 && FWCTgaReader::Probe(GetSplatmapPath(entry.tileKey.X, entry.tileKey.Y, splatmaps[0]), header))
+    {
+      outTile.mappingWidth = header.width;
+      outTile.mappingLength = header.height;
+    }
+    else if (splatmaps.Num() == 0 && version < 3)
+    {
+      outTile.mappingWidth = resX;
+      outTile.mappingLength = resY;
+    }
+  }
+  outTile.numLoadedXTiles = FMath::Max(1, loadedTilesX.Num());
+  outTile.numLoadedYTiles = FMath::Max(1, loadedTilesY.Num());
+}
+
+TSharedPtr<FWCAssembledTile> FWorldCreatorBridgeModule::AssembleUnrealTile(const FWCUnrealTile& unrealTile, const TArray<FWCManifestSplatmap>& splatmaps, int numSplatChannels, int regionStart, int regionWidth)
+{
+  TSharedPtr<FWCAssembledTile> assembledTile = MakeShared<FWCAssembledTile>();
+  assembledTile->unrealTile = unrealTile;
+
+  // a region is a band of rows of the unreal tile, without one the whole tile is assembled
+  if (regionWidth < 0)
+  {
+    regionStart = 0;
+    regionWidth = unrealTile.heightDataWidth;
+  }
+  assembledTile->regionStart = regionStart;
+  assembledTile->regionWidth = regionWidth;
+
+  const int startX = unrealTile.startX + regionStart;
+  const int startY = unrealTile.startY;
+  const int heightDataWidth = regionWidth;
+  const int heightDataLength = unrealTile.heightDataLength;
+
+  TArray<uint16>& heightData = assembledTile->heightData;
+  heightData.Init(0, heightDataWidth * heightDataLength);
+  TArray<TArray<uint8>>& splatData = assembledTile->splatData;
+  int numSplatmaps = bImportLayers ? numSplatChannels : 1;
+  int initSplatmapValue = bImportLayers ? 0 : 1;
+  splatData.Init(TArray<uint8>(), numSplatmaps);
+  for (int sp = 0; sp < splatData.Num(); sp++)
+  {
+    splatData[sp].Init(initSplatmapValue, heightDataWidth * heightDataLength);
+  }
+  const int64 assembledBytes = heightData.Num() * sizeof(uint16) + (int64)splatData.Num() * heightDataWidth * heightDataLength;
+  syncStats.AddAssembled(assembledBytes);
+  syncStats.AddBufferBytes(assembledBytes);
+  assembledTile->stats = &syncStats;
+  assembledTile->bufferBytes = assembledBytes;
+
+  //// Plan which tile rects make up the landscape
+  TArray<FWCBlitPlanEntry> plan;
+  BuildBlitPlan(startX, startY, heightDataWidth, heightDataLength, plan);
+
+  // channel counts of the splatmaps do not change per pixel, the rows are split into these planes first
+  TArray<int> splatChannelCounts;
+  for (const FWCManifestSplatmap& splatmap : splatmaps)
+  {
+    splatChannelCounts.Add(FMath::Min(splatmap.layers.Num(), (int)FWCSplatKernels::MAX_CHANNELS));
+  }
+  TArray<uint8*> splatLayers;
+  for (TArray<uint8>& layer : splatData)
+  {
+    splatLayers.Add(layer.GetData());
+  }
+
+  TMap<FIntPoint, TSharedPtr<WCLandscapeTile>> tiles;
+  LoadPlanTiles(plan, splatmaps, tiles, *assembledTile);
+
+  TArray<FWCTileRect> rects;
+  TArray<FWCTileAssembly::FKernel> kernels;
+  rects.Reserve(plan.Num());
+  kernels.Reserve(plan.Num());
+  // the kernel only changes if a tile has splatmaps with a different pixel size
+  FWCTileAssembly::FKernel assembleKernel = nullptr;
+  int assembleKernelBpp = -1;
+  int64 copiedBytes = 0;
+  for (const FWCBlitPlanEntry& entry : plan)
+  {
+    const TSharedPtr<WCLandscapeTile>& tile = tiles[entry.tileKey];
+    if (!tile.IsValid())
+      continue;
+
+    // files that are smaller than the manifest states are only copied as far as they reach
+    const int rectWidth = FMath::Min(entry.width, tile->width - entry.srcX);
+    const int rectLength = FMath::Min(entry.length, tile->height - entry.srcY);
+    if (rectWidth <= 0 || rectLength <= 0)
+      continue;
+
+    FWCTileRect& rect = rects.AddDefaulted_GetRef();
+    rect.tile = tile.Get();
+    rect.srcX = entry.srcX;
+    rect.srcY = entry.srcY;
+    rect.width = rectWidth;
+    rect.length = rectLength;
+    rect.heightData = heightData.GetData();
+    rect.splatLayers = splatLayers.GetData();
+    rect.splatChannelCounts = splatChannelCounts.GetData();
+    rect.destOffset = (int64)entry.destX * heightDataLength + entry.destY;
+    rect.destStride = heightDataLength;
+
+    if (assembleKernel == nullptr || tile->Bpp != assembleKernelBpp)
+    {
+      assembleKernel = FWCTileAssembly::GetKernel(version, bImportLayers, tile->Bpp);
+      assembleKernelBpp = tile->Bpp;
+    }
+    kernels.Add(assembleKernel);
+
+    // the heights are blitted once, the splatmaps are split into planes and those are blitted
+    const int64 rectPixels = (int64)rectWidth * rectLength;
+    copiedBytes += rectPixels * sizeof(uint16);
+    if (bImportLayers)
+    {
+      for (int j = 0; j < tile->splatmaps.Num(); j++)
+      {
+        copiedBytes += 2 * rectPixels * splatChannelCounts[j];
+      }
     }
   }
-  FFileHelper::LoadFileToArray(heightmap, heightmapPath.GetCharArray().GetData());
-  tile->heightmap = heightmap;
+  syncStats.AddCopied(copiedBytes);
+
+  //// Copy the rects, their destinations are disjoint
+  TRACE_CPUPROFILER_EVENT_SCOPE(FWorldCreatorBridgeModule::AssembleTileRects);
+  FWCSyncStats::FScopedStage stage(syncStats, EWCSyncStage::Assembly, assembledBytes);
+  // every worker allocates its scratch planes once and reuses them for all rects it executes
+  struct FScratchPlanes
+  {
+    TArray<uint8> splatRows[FWCSplatKernels::MAX_CHANNELS];
+  };
+  TArray<FScratchPlanes> scratchPlanes;
+  ParallelForWithTaskContext(scratchPlanes, rects.Num(), [&rects, &kernels](FScratchPlanes& scratch, int32 rectIndex)
+    {
+      FWCTileRect rect = rects[rectIndex];
+      rect.splatRows = scratch.splatRows;
+      kernels[rectIndex](rect);
+    });
+
+  return assembledTile;
+}
+
+TSharedPtr<WCLandscapeTile> FWorldCreatorBridgeModule::TileToData(int tileX, int tileY, const TArray<FWCManifestSplatmap>& splatmaps)
+{
+  // tasks that need a tile another task is reading wait for it instead of reading it a second time
+  return tileCache.FindOrLoad(FIntPoint(tileX, tileY), [this, tileX, tileY, &splatmaps]()
+    {
+      return ReadTile(tileX, tileY, splatmaps);
+    });
+}
+
+TSharedPtr<WCLandscapeTile> FWorldCreatorBridgeModule::ReadTile(int tileX, int tileY, const TArray<FWCManifestSplatmap>& splatmaps)
+{
+  TRACE_CPUPROFILER_EVENT_SCOPE(FWorldCreatorBridgeModule::ReadTile);
+  FWCSyncStats::FScopedStage stage(syncStats, EWCSyncStage::TileRead);
+  TSharedPtr<WCLandscapeTile> tile = MakeShared<WCLandscapeTile>();
+  for (int i = 0; i < splatmaps.Num(); i++)
+  {
+    const FString filePath = GetSplatmapPath(tileX, tileY, splatmaps[i]);
+
+    FWCMappedFile fileData;
+    FWCTgaHeader header;
+    if (!fileData.Open(filePath) || !FWCTgaReader::ParseHeader(fileData.GetData(), fileData.Num(), header))
+    {
+      return nullptr;
+    }
+    // files that cannot be mapped are loaded into memory
+    if (!fileData.IsMapped())
+      syncStats.AddCopied(fileData.GetFileSize());
+
+    if (i == 0)
+    {
+      tile->height = header.height;
+      tile->width = header.width;
+      tile->Bpp = header.GetBytesPerPixel();
+    }
+    else if (header.width != tile->width || header.height != tile->height || header.GetBytesPerPixel() != tile->Bpp)
+    {
+      // the assembly reads all splatmaps of a tile with the layout of the first one
+      UE_LOG(LogTemp, Error, TEXT("Splatmap %s is %dx%d with %d bytes per pixel, the first splatmap of the tile is %dx%d with %d"),
+        *filePath, header.width, header.height, header.GetBytesPerPixel(), tile->width, tile->height, tile->Bpp);
+      return nullptr;
+    }
+
+    if (FWCTgaReader::CanReadInPlace(header))
+    {
+      if (header.GetPixelDataOffset() + header.GetImageSize() > fileData.Num())
+      {
+        UE_LOG(LogTemp, Error, TEXT("Splatmap %s is truncated"), *filePath);
+        return nullptr;
+      }
+      // skip the tga header without moving the pixel data
+      fileData.SetViewOffset(header.GetPixelDataOffset());
+    }
+    else
+    {
+      // compressed or flipped files are decoded once into the layout of uncompressed files
+      TArray<uint8> decodedData;
+      decodedData.SetNumUninitialized(header.GetImageSize());
+      if (!FWCTgaReader::Decode(header, fileData.GetData(), fileData.Num(), decodedData.GetData()))
+      {
+        UE_LOG(LogTemp, Error, TEXT("Failed to decode splatmap %s"), *filePath);
+        return nullptr;
+      }
+      syncStats.AddCopied(decodedData.Num());
+      fileData.AdoptBuffer(MoveTemp(decodedData));
+    }
+    tile->splatmaps.Add(MoveTemp(fileData));
+  }
+
+  if (version < 3 && splatmaps.Num() == 0)
+  {
+    tile->width = resX;
+    tile->height = resY;
+  }
+  if (!tile->heightmap.Open(GetHeightmapPath(tileX, tileY)))
+  {
+    return nullptr;
+  }
+  if (!tile->heightmap.IsMapped())
+    syncStats.AddCopied(tile->heightmap.GetFileSize());
+  if (tile->heightmap.Num() < (int64)tile->width * tile->height * (int64)sizeof(uint16))
+  {
+    UE_LOG(LogTemp, Error, TEXT("Heightmap %s is smaller than %dx%d"), *GetHeightmapPath(tileX, tileY), tile->width, tile->height);
+    return nullptr;
+  }
+  stage.AddBytes(tile->GetAllocatedSize());
   return tile;
 }
 
+FString FWorldCreatorBridgeModule::GetHeightmapPath(int tileX, int tileY) const
+{
+  if (version >= 3)
+  {
+    return FString::Printf(TEXT("%s/heightmap_%d_%d.%s"), syncDir.GetCharArray().GetData(), tileX, tileY, &HEIGHTMAP_FILEENDING);
+  }
+  return FString::Printf(TEXT("%s/heightmap.%s"), syncDir.GetCharArray().GetData(), &HEIGHTMAP_FILEENDING);
+}
+
+FString FWorldCreatorBridgeModule::GetSplatmapPath(int tileX, int tileY, const FWCManifestSplatmap& splatmap) const
+{
+  int splatmapIndex = FMath::Max(0, splatmap.index);
+  if (version >= 3 && splatmapIndex >= 0) // THE && condition can be removed in future versions, it is a temporary solution for the 1.1 version (2023.1.1b) of the beta
+  {
+    return FString::Printf(TEXT("%s/splatmap_%d_%d_%d.%s"), syncDir.GetCharArray().GetData(), splatmapIndex, tileX, tileY, SPLATMAP_FILEENDING);
+  }
+  return FString::Printf(TEXT("%s/%s"), syncDir.GetCharArray().GetData(), splatmap.name.GetCharArray().GetData());
+}
+
+TArray<FString> FWorldCreatorBridgeModule::GetTileFilePaths(const FIntPoint& tileKey, const TArray<FWCManifestSplatmap>& splatmaps) const
+{
+  TArray<FString> filePaths;
+  filePaths.Add(GetHeightmapPath(tileKey.X, tileKey.Y));
+  for (const FWCManifestSplatmap& splatmap : splatmaps)
+  {
+    filePaths.Add(GetSplatmapPath(tileKey.X, tileKey.Y, splatmap));
+  }
+  return filePaths;
+}
+
 FReply FWorldCreatorBridgeModule::BuildMinimapButtonClicked()
 {
   auto context = GEditor->GetEditorWorldContext();
@@ -1272,7 +1991,12 @@ FReply FWorldCreatorBridgeModule::BrowseButtonClicked()
   return FReply::Handled();
 }
 
-UMaterial* FWorldCreatorBridgeModule::CreateLandscapeMaterial(int terrainId, int _numTilesX, int _numTilesY, int startX, int startY, int mappingWidth, int mappingLength)
+static FName GetColormapSlotParameter(const TCHAR* name, int x, int y)
+{
+  return FName(*FString::Printf(TEXT("%s_%d_%d"), name, x, y));
+}
+
+UMaterial* FWorldCreatorBridgeModule::CreateParentMaterial(int slotsX, int slotsY)
 {
   /*FString tmpMatPath = FString::Printf(TEXT("%s%s_%d"), MATERIAL_PACKAGE_NAME_PREFIX.GetCharArray().GetData(), this->terrainMaterialName.GetCharArray().GetData(), terrainId);
   FSoftObjectPath matPath(tmpMatPath);
@@ -1285,11 +2009,22 @@ UMaterial* FWorldCreatorBridgeModule::CreateLandscapeMaterial(int terrainId, int
   /////////////////////
   FString MaterialPackageName = MATERIAL_PACKAGE_NAME_PREFIX + this->terrainMaterialName;
   UPackage* materialPackage = CreatePackage(*MaterialPackageName);
+  materialPackage->FullyLoad();
+
+  // a material that was built from the same inputs is reused as it is, rebuilding it recompiles all its shaders
+  const FString graphHash = LexToString(GetMaterialGraphHash(slotsX, slotsY));
+  UMaterial* existingMaterial = FindObject<UMaterial>(materialPackage, *(this->terrainMaterialName));
+  if (existingMaterial != nullptr)
+  {
+    if (materialPackage->GetMetaData()->GetValue(existingMaterial, MATERIAL_GRAPH_HASH_KEY) == graphHash)
+      return existingMaterial;
+    // landscapes that render with a material that is replaced in place are refreshed when the sync finishes
+    bRefreshLandscapeMaterials = true;
+  }
   auto MaterialFactory = NewObject<UMaterialFactoryNew>();
   // UMaterial* material = (UMaterial*)MaterialFactory->FactoryCreateNew(UMaterial::StaticClass(), materialPackage, *(FString::Printf(TEXT("%s_%d"), this->terrainMaterialName.GetCharArray().GetData(), terrainId)), RF_Standalone | RF_Public, NULL, GWarn);
   UMaterial* material = NewObject<UMaterial>(materialPackage, *(this->terrainMaterialName), RF_Public | RF_Standalone | RF_Transactional);
   FAssetRegistryModule::AssetCreated(material);
-  materialPackage->FullyLoad();
   materialPackage->SetDirtyFlag(true);  
 
   FMaterialExpressionCollection* expressionCollection = &material->GetExpressionCollection();
@@ -1303,14 +2038,12 @@ UMaterial* FWorldCreatorBridgeModule::CreateLandscapeMaterial(int terrainId, int
   }
   expressioncopy.Empty();
 
+  // identical expressions are only created once, unused ones are removed by Finish
+  FWCMaterialGraphBuilder graph(material);
+
   /// create layerblend nodes in the material
   /////////////////////////////////////////////
-  UMaterialExpressionLandscapeLayerBlend* AlbedoLayerBlend = NewObject<UMaterialExpressionLandscapeLayerBlend>(material);
-  AlbedoLayerBlend->MaterialExpressionEditorX = -200.0f;
-  AlbedoLayerBlend->MaterialExpressionEditorY = 50.0f;
-  expressionCollection->AddExpression(AlbedoLayerBlend);
-
-
+  UMaterialExpressionLandscapeLayerBlend* AlbedoLayerBlend = graph.NewExpression<UMaterialExpressionLandscapeLayerBlend>();
   UMaterialExpressionLandscapeLayerBlend* NormalLayerBlend = nullptr;
   UMaterialExpressionLandscapeLayerBlend* AOLayerBlend = nullptr;
   UMaterialExpressionLandscapeLayerBlend* DisplacementLayerBlend = nullptr;
@@ -1318,342 +2051,52 @@ UMaterial* FWorldCreatorBridgeModule::CreateLandscapeMaterial(int terrainId, int
 
   if (bImportLayers)
   {
-    NormalLayerBlend = NewObject<UMaterialExpressionLandscapeLayerBlend>(material);
-    NormalLayerBlend->MaterialExpressionEditorX = -200.0f;
-    NormalLayerBlend->MaterialExpressionEditorY = 250.0f;
-    expressionCollection->AddExpression(NormalLayerBlend);
-
-    AOLayerBlend = NewObject<UMaterialExpressionLandscapeLayerBlend>(material);
-    AOLayerBlend->MaterialExpressionEditorX = -200.0f;
-    AOLayerBlend->MaterialExpressionEditorY = 450.0f;
-    expressionCollection->AddExpression(AOLayerBlend);
-
-    DisplacementLayerBlend = NewObject<UMaterialExpressionLandscapeLayerBlend>(material);
-    DisplacementLayerBlend->MaterialExpressionEditorX = -200.0f;
-    DisplacementLayerBlend->MaterialExpressionEditorY = 350.0f;
-    expressionCollection->AddExpression(DisplacementLayerBlend);
-
-    RoughnessLayerBlend = NewObject<UMaterialExpressionLandscapeLayerBlend>(material);
-    RoughnessLayerBlend->MaterialExpressionEditorX = -200.0f;
-    RoughnessLayerBlend->MaterialExpressionEditorY = 150.0f;
-    expressionCollection->AddExpression(RoughnessLayerBlend);
+    NormalLayerBlend = graph.NewExpression<UMaterialExpressionLandscapeLayerBlend>();
+    AOLayerBlend = graph.NewExpression<UMaterialExpressionLandscapeLayerBlend>();
+    DisplacementLayerBlend = graph.NewExpression<UMaterialExpressionLandscapeLayerBlend>();
+    RoughnessLayerBlend = graph.NewExpression<UMaterialExpressionLandscapeLayerBlend>();
   }
 
   /// add and remap landscape coordinates to the material
   /////////////////////////////////////////////////////////
-  UMaterialExpressionLandscapeLayerCoords* LandscapeCoords = NewObject<UMaterialExpressionLandscapeLayerCoords>(material);
-
-  //LandscapeCoords->MappingRotation = 180.0f; // TODO this is a test because i rotated the terrain 
-  float originalLandscapeCoordX = -2600.0f;
-  LandscapeCoords->MaterialExpressionEditorX = originalLandscapeCoordX;
-  LandscapeCoords->MaterialExpressionEditorY = -350.0f;
-  expressionCollection->AddExpression(LandscapeCoords);
-  /// Create empty texture nodes for the cases where a layer only has colordata. Leaving layers in a layerblend emplty has resulted in render issues
-  /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-  UMaterialExpressionVectorParameter* emptyNormalVectorParam = NewObject<UMaterialExpressionVectorParameter>(material);
-  emptyNormalVectorParam->ParameterName = FName(FString::Printf(TEXT("emptyNormal")));
-  emptyNormalVectorParam->MaterialExpressionEditorX = -1500.0f;
-  emptyNormalVectorParam->MaterialExpressionEditorY = -400.0f;
-  expressionCollection->AddExpression(emptyNormalVectorParam);
-  material->SetVectorParameterValueEditorOnly(FString::Printf(TEXT("emptyNormal")).GetCharArray().GetData(), FColor(128, 128, 255, 255));
-  UMaterialExpressionVectorParameter* emptyAOVectorParam = NewObject<UMaterialExpressionVectorParameter>(material);
-  emptyAOVectorParam->ParameterName = FName(FString::Printf(TEXT("emptyAO")));
-  emptyAOVectorParam->MaterialExpressionEditorX = -1500.0f;
-  emptyAOVectorParam->MaterialExpressionEditorY = -1000.0f;
-  expressionCollection->AddExpression(emptyAOVectorParam);
-  material->SetVectorParameterValueEditorOnly(FString::Printf(TEXT("emptyAO")).GetCharArray().GetData(), FColor(255, 255, 255, 255));
-  UMaterialExpressionVectorParameter* emptyDisplacementVectorParam = NewObject<UMaterialExpressionVectorParameter>(material);
-  emptyDisplacementVectorParam->ParameterName = FName(FString::Printf(TEXT("emptyDisplacement")));
-  emptyDisplacementVectorParam->MaterialExpressionEditorX = -1500.0f;
-  emptyDisplacementVectorParam->MaterialExpressionEditorY = -800.0f;
-  expressionCollection->AddExpression(emptyDisplacementVectorParam);
-  material->SetVectorParameterValueEditorOnly(FString::Printf(TEXT("emptyDisplacement")).GetCharArray().GetData(), FColor(0, 0, 0, 255));
-  UMaterialExpressionVectorParameter* emptyRoughnessVectorParam = NewObject<UMaterialExpressionVectorParameter>(material);
-  emptyRoughnessVectorParam->ParameterName = FName(FString::Printf(TEXT("emptyRoughness")));
-  emptyRoughnessVectorParam->MaterialExpressionEditorX = -1500.0f;
-  emptyRoughnessVectorParam->MaterialExpressionEditorY = -600.0f;
-  expressionCollection->AddExpression(emptyRoughnessVectorParam);
-  material->SetVectorParameterValueEditorOnly(FString::Printf(TEXT("emptyRoughness")).GetCharArray().GetData(), FColor(255, 255, 255, 255));
-  UMaterialExpressionConstant* zeroConstant = NewObject<UMaterialExpressionConstant>(material);
-  zeroConstant->R = 0.0f;
-  zeroConstant->MaterialExpressionEditorX = -1000.0f;
-  zeroConstant->MaterialExpressionEditorY = -600;
-  expressionCollection->AddExpression(zeroConstant);
-
-  int startTileX = startX / WC_TILE_RESOLUTION;
-  int startTileY = startY / WC_TILE_RESOLUTION;
-
-  UMaterialExpressionAdd* addedTextrueExpression = nullptr;
-  int tileMatXPos = -500;
-  int tileMatYPos = 0;
-
-
-  UMaterialExpressionConstant* MO = NewObject<UMaterialExpressionConstant>(material);
-  MO->R = -1;
-  expressionCollection->AddExpression(MO);
-  MO->MaterialExpressionEditorX = -1000.0f;
-  MO->MaterialExpressionEditorY = -200;
-
-  UMaterialExpressionConstant* oneHundred = NewObject<UMaterialExpressionConstant>(material);
-  oneHundred->R = 100.0f;
-  oneHundred->MaterialExpressionEditorX = -1000.0f;
-  oneHundred->MaterialExpressionEditorY = -300;
-  expressionCollection->AddExpression(oneHundred);
-  UMaterialExpressionConstant* widthConstant = NewObject<UMaterialExpressionConstant>(material);
-  widthConstant->R = mappingWidth;
-  widthConstant->MaterialExpressionEditorX = -1000.0f;
-  widthConstant->MaterialExpressionEditorY = -400;
-  expressionCollection->AddExpression(widthConstant);
-  UMaterialExpressionConstant* lengthConstant = NewObject<UMaterialExpressionConstant>(material);
-  lengthConstant->R = mappingLength;
-  lengthConstant->MaterialExpressionEditorX = -1000.0f;
-  lengthConstant->MaterialExpressionEditorY = -500;
-  expressionCollection->AddExpression(lengthConstant);
-
-  UMaterialExpressionComponentMask* maskLandscapeCoordX = NewObject<UMaterialExpressionComponentMask>(material);
-  maskLandscapeCoordX->R = 1;
-  maskLandscapeCoordX->G = 0;
-  maskLandscapeCoordX->B = 0;
-  maskLandscapeCoordX->A = 0;
-  maskLandscapeCoordX->Input.Expression = LandscapeCoords;
-  maskLandscapeCoordX->MaterialExpressionEditorX = -2400.0f;
-  maskLandscapeCoordX->MaterialExpressionEditorY = -400;
-  expressionCollection->AddExpression(maskLandscapeCoordX);
-  UMaterialExpressionComponentMask* maskLandscapeCoordY = NewObject<UMaterialExpressionComponentMask>(material);
-  maskLandscapeCoordY->R = 0;
-  maskLandscapeCoordY->G = 1;
-  maskLandscapeCoordY->B = 0;
-  maskLandscapeCoordY->A = 0;
-  maskLandscapeCoordY->Input.Expression = LandscapeCoords;
-  maskLandscapeCoordY->MaterialExpressionEditorX = -2400.0f;
-  maskLandscapeCoordY->MaterialExpressionEditorY = -300;
-  expressionCollection->AddExpression(maskLandscapeCoordY);
-
-  UMaterialExpressionDivide* landscapeCoordXDivide = NewObject <UMaterialExpressionDivide>(material);
-  UMaterialExpressionDivide* landscapeCoordYDivide = NewObject <UMaterialExpressionDivide>(material);
-  landscapeCoordXDivide->A.Expression = maskLandscapeCoordX;
-  landscapeCoordYDivide->A.Expression = maskLandscapeCoordY;
-  landscapeCoordXDivide->B.Expression = lengthConstant;
-  landscapeCoordYDivide->B.Expression = widthConstant;
-  landscapeCoordYDivide->MaterialExpressionEditorX = -2200.0f;
-  landscapeCoordYDivide->MaterialExpressionEditorY = -300;
-  landscapeCoordXDivide->MaterialExpressionEditorX = -2200.0f;
-  landscapeCoordXDivide->MaterialExpressionEditorY = -400;
-  expressionCollection->AddExpression(landscapeCoordXDivide);
-  expressionCollection->AddExpression(landscapeCoordYDivide);
-
-  UMaterialExpressionAppendVector* fittetLandscapeCoord = NewObject<UMaterialExpressionAppendVector>(material);
-  fittetLandscapeCoord->A.Expression = landscapeCoordXDivide;
-  fittetLandscapeCoord->B.Expression = landscapeCoordYDivide;
-  fittetLandscapeCoord->MaterialExpressionEditorX = -2000.0f;
-  fittetLandscapeCoord->MaterialExpressionEditorY = -350;
-  expressionCollection->AddExpression(fittetLandscapeCoord);
+  UMaterialExpression* LandscapeCoords = graph.LandscapeCoords();
 
+  // everything that differs between the landscapes of a terrain is a parameter, set by their material instances
+  UMaterialExpression* widthConstant = graph.ScalarParameter(MAPPING_WIDTH_PARAMETER, tileResolution);
+  UMaterialExpression* lengthConstant = graph.ScalarParameter(MAPPING_LENGTH_PARAMETER, tileResolution);
+  UTexture* defaultColormap = LoadObject<UTexture>(nullptr, TEXT("/Engine/EngineResources/DefaultTexture.DefaultTexture"));
 
-  for (int x = 0; x < _numTilesX; x++)
+  // one slot per colormap tile a landscape can cover. Slots a landscape does not use keep the default offset, which
+  // moves them out of the 0..mapping range so their mask is 0
+  UMaterialExpression* addedTextrueExpression = nullptr;
+  for (int x = 0; x < slotsX; x++)
   {
-    for (int y = 0; y < _numTilesY; y++)
+    for (int y = 0; y < slotsY; y++)
     {
-      int tmpx = x + startTileX;
-      int tmpy = y + startTileY;
-      FString baseMapName = bImportLayers ? COLORMAP_NAME : TEXTUREMAP_NAME;
-      FString diffuseAssetPath;
-      if (version >= 3)
-      {
-        diffuseAssetPath = FString::Printf(TEXT("%s%s_%d_%d"),
-          MATERIAL_PACKAGE_NAME_PREFIX.GetCharArray().GetData(),
-          baseMapName.GetCharArray().GetData(),
-          tmpx, tmpy);
-      }
-      else
-      {
-        diffuseAssetPath = FString::Printf(TEXT("%s%s"),
-          MATERIAL_PACKAGE_NAME_PREFIX.GetCharArray().GetData(),
-          baseMapName.GetCharArray().GetData());
-      }
-
-      // add a vector parametarization here 
-      UMaterialExpressionConstant2Vector* landscapeUVOffset = NewObject<UMaterialExpressionConstant2Vector>(material);
-      landscapeUVOffset->G = startX % WC_TILE_RESOLUTION - (mappingWidth * x);
-      landscapeUVOffset->R = startY % WC_TILE_RESOLUTION - (mappingLength * y);
-      landscapeUVOffset->MaterialExpressionEditorX = originalLandscapeCoordX + 100 + tileMatXPos;
-      landscapeUVOffset->MaterialExpressionEditorY = tileMatYPos + 200.0f;
-      expressionCollection->AddExpression(landscapeUVOffset);
-
-      UMaterialExpressionAdd* addExpression = NewObject<UMaterialExpressionAdd>(material);
-      expressionCollection->AddExpression(addExpression);
-      addExpression->A.Expression = LandscapeCoords;
-      addExpression->B.Expression = landscapeUVOffset;
-      addExpression->MaterialExpressionEditorX = originalLandscapeCoordX + 250 + tileMatXPos;
-      addExpression->MaterialExpressionEditorY = tileMatYPos + 200.0f;
-      LandscapeCoords->MaterialExpressionEditorX = originalLandscapeCoordX + tileMatXPos;
-
-      UMaterialExpressionComponentMask* maskLandscapeX = NewObject<UMaterialExpressionComponentMask>(material);
-      maskLandscapeX->R = 1;
-      maskLandscapeX->G = 0;
-      maskLandscapeX->B = 0;
-      maskLandscapeX->A = 0;
-      maskLandscapeX->Input.Expression = addExpression;
-      expressionCollection->AddExpression(maskLandscapeX);
-      UMaterialExpressionComponentMask* maskLandscapeY = NewObject<UMaterialExpressionComponentMask>(material);
-      maskLandscapeY->R = 0;
-      maskLandscapeY->G = 1;
-      maskLandscapeY->B = 0;
-      maskLandscapeY->A = 0;
-      maskLandscapeY->Input.Expression = addExpression;
-      expressionCollection->AddExpression(maskLandscapeY);
-      maskLandscapeX->MaterialExpressionEditorX = originalLandscapeCoordX + 400 + tileMatXPos;
-      maskLandscapeX->MaterialExpressionEditorY = tileMatYPos + 150.0f;
-      maskLandscapeY->MaterialExpressionEditorX = originalLandscapeCoordX + 400 + tileMatXPos;
-      maskLandscapeY->MaterialExpressionEditorY = tileMatYPos + 250.0f;
-
-      UMaterialExpressionMin* startMin = NewObject<UMaterialExpressionMin>(material);
-      startMin->A.Expression = maskLandscapeY;
-      startMin->B.Expression = maskLandscapeX;
-      startMin->MaterialExpressionEditorX = originalLandscapeCoordX + 550 + tileMatXPos;
-      startMin->MaterialExpressionEditorY = tileMatYPos + 150.0f;
-      expressionCollection->AddExpression(startMin);
-
-      UMaterialExpressionDivide* widthDivider = NewObject < UMaterialExpressionDivide>(material);
-      widthDivider->A.Expression = maskLandscapeY;
-      widthDivider->B.Expression = widthConstant;
-      widthDivider->MaterialExpressionEditorX = originalLandscapeCoordX + 650 + tileMatXPos;
-      widthDivider->MaterialExpressionEditorY = tileMatYPos + 250.0f;
-      expressionCollection->AddExpression(widthDivider);
-
-      UMaterialExpressionMultiply* MOmultLandscapeX = NewObject<UMaterialExpressionMultiply>(material);
-      MOmultLandscapeX->A.Expression = maskLandscapeX;
-      MOmultLandscapeX->B.Expression = MO;
-      MOmultLandscapeX->MaterialExpressionEditorX = originalLandscapeCoordX + 550 + tileMatXPos;
-      MOmultLandscapeX->MaterialExpressionEditorY = tileMatYPos + 0.0f;
-      expressionCollection->AddExpression(MOmultLandscapeX);
-
-      UMaterialExpressionAdd* newLandscapeX = NewObject<UMaterialExpressionAdd>(material);
-      newLandscapeX->A.Expression = lengthConstant;
-      newLandscapeX->B.Expression = MOmultLandscapeX;
-      newLandscapeX->MaterialExpressionEditorX = originalLandscapeCoordX + 700 + tileMatXPos;
-      newLandscapeX->MaterialExpressionEditorY = tileMatYPos + 0.0f;
-      expressionCollection->AddExpression(newLandscapeX);
-
-      UMaterialExpressionDivide* lengthDivider = NewObject < UMaterialExpressionDivide>(material);
-      lengthDivider->A.Expression = newLandscapeX;
-      lengthDivider->B.Expression = lengthConstant;
-      lengthDivider->MaterialExpressionEditorX = originalLandscapeCoordX + 850 + tileMatXPos;
-      lengthDivider->MaterialExpressionEditorY = tileMatYPos + 150.0f;
-      expressionCollection->AddExpression(lengthDivider);
-
-      UMaterialExpressionAppendVector* newLandscapeUV = NewObject<UMaterialExpressionAppendVector>(material);
-      newLandscapeUV->A.Expression = widthDivider;
-      newLandscapeUV->B.Expression = lengthDivider;
-      newLandscapeUV->MaterialExpressionEditorX = originalLandscapeCoordX + 1000 + tileMatXPos;
-      newLandscapeUV->MaterialExpressionEditorY = tileMatYPos + 200.0f;
-      expressionCollection->AddExpression(newLandscapeUV);
-
-      FSoftObjectPath DiffuseAssetPath(diffuseAssetPath);
-      UTexture* DiffuseTexture = Cast<UTexture>(DiffuseAssetPath.TryLoad());
-      UMaterialExpressionTextureSample* TextureExpression = NewObject<UMaterialExpressionTextureSample>(material);
-      TextureExpression->Texture = DiffuseTexture;
-      TextureExpression->SamplerType = SAMPLERTYPE_Color;
-      expressionCollection->AddExpression(TextureExpression);
-      TextureExpression->Coordinates.Expression = newLandscapeUV;
-      TextureExpression->MaterialExpressionEditorX = originalLandscapeCoordX + 1150.0f + tileMatXPos;
-      TextureExpression->MaterialExpressionEditorY = tileMatYPos + 200.0f;
-
-
-      UMaterialExpressionMultiply* multByMO = NewObject<UMaterialExpressionMultiply>(material);
-
-      multByMO->A.Expression = addExpression;
-      multByMO->B.Expression = MO;
-      multByMO->MaterialExpressionEditorX = originalLandscapeCoordX + 1300.0f + tileMatXPos;
-      multByMO->MaterialExpressionEditorY = tileMatYPos + 200.0f;
-      expressionCollection->AddExpression(multByMO);
-
-      UMaterialExpressionAppendVector* mappingVec = NewObject<UMaterialExpressionAppendVector>(material);
-      mappingVec->A.Expression = lengthConstant;
-      mappingVec->B.Expression = widthConstant;
-      mappingVec->MaterialExpressionEditorX = originalLandscapeCoordX + 1450.0f + tileMatXPos;
-      mappingVec->MaterialExpressionEditorY = tileMatYPos + 100.0f;
-      expressionCollection->AddExpression(mappingVec);
-
-      UMaterialExpressionAdd* clipValueExpression = NewObject<UMaterialExpressionAdd>(material);
-      clipValueExpression->A.Expression = mappingVec;
-      clipValueExpression->B.Expression = multByMO;
-
-      clipValueExpression->MaterialExpressionEditorX = originalLandscapeCoordX + 1600.0f + tileMatXPos;
-      clipValueExpression->MaterialExpressionEditorY = tileMatYPos + 200.0f;
-      expressionCollection->AddExpression(clipValueExpression);
-
-      UMaterialExpressionComponentMask* maskR = NewObject<UMaterialExpressionComponentMask>(material);
-      maskR->R = 1;
-      maskR->G = 0;
-      maskR->B = 0;
-      maskR->A = 0;
-      maskR->Input.Expression = clipValueExpression;
-      expressionCollection->AddExpression(maskR);
-      UMaterialExpressionComponentMask* maskG = NewObject<UMaterialExpressionComponentMask>(material);
-      maskG->R = 0;
-      maskG->G = 1;
-      maskG->B = 0;
-      maskG->A = 0;
-      maskG->Input.Expression = clipValueExpression;
-      expressionCollection->AddExpression(maskG);
-
-      maskR->MaterialExpressionEditorX = originalLandscapeCoordX + 1750.0f + tileMatXPos;
-      maskR->MaterialExpressionEditorY = tileMatYPos + 150.0f;
-      maskG->MaterialExpressionEditorX = originalLandscapeCoordX + 1750.0f + tileMatXPos;
-      maskG->MaterialExpressionEditorY = tileMatYPos + 250.0f;
-
-      UMaterialExpressionMin* endMin = NewObject<UMaterialExpressionMin>(material);
-      endMin->A.Expression = maskR;
-      endMin->B.Expression = maskG;
-      endMin->MaterialExpressionEditorX = originalLandscapeCoordX + 1900.0f + tileMatXPos;
-      endMin->MaterialExpressionEditorY = tileMatYPos + 250.0f;
-      expressionCollection->AddExpression(endMin);
-
-      UMaterialExpressionMin* minExpression = NewObject<UMaterialExpressionMin>(material);
-      minExpression->A.Expression = endMin;
-      minExpression->B.Expression = startMin;
-      minExpression->MaterialExpressionEditorX = originalLandscapeCoordX + 2050.0f + tileMatXPos;
-      minExpression->MaterialExpressionEditorY = tileMatYPos + 200.0f;
-      expressionCollection->AddExpression(minExpression);
-
-      UMaterialExpressionMultiply* multiplyerExpression = NewObject<UMaterialExpressionMultiply>(material);
-      multiplyerExpression->A.Expression = minExpression;
-      multiplyerExpression->B.Expression = oneHundred;
-      multiplyerExpression->MaterialExpressionEditorX = originalLandscapeCoordX + 2200.0f + tileMatXPos;
-      multiplyerExpression->MaterialExpressionEditorY = tileMatYPos + 200.0f;
-      expressionCollection->AddExpression(multiplyerExpression);
-
-      UMaterialExpressionClamp* clampExpression = NewObject<UMaterialExpressionClamp>(material);
-      clampExpression->Input.Expression = multiplyerExpression;
-      clampExpression->MaterialExpressionEditorX = originalLandscapeCoordX + 2350.0f + tileMatXPos;
-      clampExpression->MaterialExpressionEditorY = tileMatYPos + 200.0f;
-      expressionCollection->AddExpression(clampExpression);
-
-
-      UMaterialExpressionMultiply* finalTextureExpression = NewObject<UMaterialExpressionMultiply>(material);
-      finalTextureExpression->A.Expression = TextureExpression;
-      finalTextureExpression->B.Expression = clampExpression;
-      finalTextureExpression->MaterialExpressionEditorX = originalLandscapeCoordX + 2300.0f + tileMatXPos;
-      finalTextureExpression->MaterialExpressionEditorY = tileMatYPos + 0.0f;
-      expressionCollection->AddExpression(finalTextureExpression);
-
-      UMaterialExpressionAdd* tmpAddedTextureExpression = NewObject<UMaterialExpressionAdd>(material);
-      tmpAddedTextureExpression->A.Expression = finalTextureExpression;
-      tmpAddedTextureExpression->B.Expression = zeroConstant;
-      tmpAddedTextureExpression->MaterialExpressionEditorX = originalLandscapeCoordX + 2650 + tileMatXPos;
-      tmpAddedTextureExpression->MaterialExpressionEditorY = tileMatYPos + 200.0f;
-
-      if (addedTextrueExpression != nullptr)
-      {
-        tmpAddedTextureExpression->B.Expression = addedTextrueExpression;
-      }
-      expressionCollection->AddExpression(tmpAddedTextureExpression);
-      addedTextrueExpression = tmpAddedTextureExpression;
-      tileMatXPos -= 700.0f;
-      tileMatYPos += 400.0f;
+      UMaterialExpression* landscapeUVOffset = graph.Mask(graph.VectorParameter(GetColormapSlotParameter(COLORMAP_OFFSET_PARAMETER, x, y),
+        FLinearColor(-UNUSED_SLOT_OFFSET, -UNUSED_SLOT_OFFSET, 0.0f, 0.0f)), true, true);
+      UMaterialExpression* tileCoords = graph.Add(LandscapeCoords, landscapeUVOffset);
+      UMaterialExpression* tileCoordX = graph.Mask(tileCoords, true, false);
+      UMaterialExpression* tileCoordY = graph.Mask(tileCoords, false, true);
+
+      // u runs along G, v is flipped along R
+      UMaterialExpression* newLandscapeUV = graph.Append(graph.Divide(tileCoordY, widthConstant),
+        graph.Divide(graph.Subtract(lengthConstant, tileCoordX), lengthConstant));
+      UMaterialExpression* TextureExpression = graph.TextureSampleParameter(GetColormapSlotParameter(COLORMAP_TEXTURE_PARAMETER, x, y),
+        defaultColormap, newLandscapeUV, SAMPLERTYPE_Color);
+
+      // 1 inside the tile and 0 outside, the distance to the nearest border is scaled so the edge stays sharp
+      UMaterialExpression* clipValueExpression = graph.Subtract(graph.Append(lengthConstant, widthConstant), tileCoords);
+      UMaterialExpression* startMin = graph.Min(tileCoordY, tileCoordX);
+      UMaterialExpression* endMin = graph.Min(graph.Mask(clipValueExpression, true, false), graph.Mask(clipValueExpression, false, true));
+      UMaterialExpression* clampExpression = graph.Clamp(graph.Multiply(graph.Min(endMin, startMin), graph.Constant(100.0f)));
+
+      UMaterialExpression* finalTextureExpression = graph.Multiply(TextureExpression, clampExpression);
+      addedTextrueExpression = addedTextrueExpression != nullptr ? graph.Add(finalTextureExpression, addedTextrueExpression) : finalTextureExpression;
     }
   }
+  if (colormapArray.IsValid())
+    addedTextrueExpression = CreateColormapArraySample(graph, LandscapeCoords, colormapArray.Get());
 
   //// Load Splatmap & Textures
   ///////////////////////////////
@@ -1662,30 +2105,43 @@ UMaterial* FWorldCreatorBridgeModule::CreateLandscapeMaterial(int terrainId, int
   //// TODO for Tomorrow this can be put into a function and added to the loop below
   if (bImportLayers)
   {
-    auto texturingNode = root->FindChildNode(TEXT("Texturing"));
-    if (texturingNode != nullptr)
+    if (manifest->bHasTexturing)
     {
+      /// Create empty texture nodes for the cases where a layer only has colordata. Leaving layers in a layerblend emplty has resulted in render issues
+      /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+      UMaterialExpression* emptyNormalVectorParam = graph.VectorParameter(TEXT("emptyNormal"), FColor(128, 128, 255, 255));
+      UMaterialExpression* emptyAOVectorParam = graph.VectorParameter(TEXT("emptyAO"), FColor(255, 255, 255, 255));
+      UMaterialExpression* emptyDisplacementVectorParam = graph.VectorParameter(TEXT("emptyDisplacement"), FColor(0, 0, 0, 255));
+      UMaterialExpression* emptyRoughnessVectorParam = graph.VectorParameter(TEXT("emptyRoughness"), FColor(255, 255, 255, 255));
+
+      // layers sample the slice of their texture in the array of its map type, the slices are in layer order. A
+      // texture that is not in its slice, because the array is out of date or could not be built, is sampled directly
+      UTexture2DArray* layerArrays[LAYER_MAP_COUNT] = {};
+      int layerSlices[LAYER_MAP_COUNT] = {};
+      for (int layerMap = 0; bLayerTextureArrays && layerMap < LAYER_MAP_COUNT; layerMap++)
+      {
+        layerArrays[layerMap] = LoadLayerArray(layerMap);
+      }
+      auto sampleLayerMap = [&graph, &layerArrays, &layerSlices](int layerMap, UTexture2D* texture, UMaterialExpression* layerUV, EMaterialSamplerType samplerType)
+      {
+        const int slice = layerSlices[layerMap]++;
+        UTexture2DArray* layerArray = layerArrays[layerMap];
+        if (layerArray != nullptr && layerArray->SourceTextures.IsValidIndex(slice) && layerArray->SourceTextures[slice] == texture)
+          return graph.TextureSample(layerArray, graph.Append(layerUV, graph.Constant(slice)), samplerType);
+        return graph.TextureSample(texture, layerUV, samplerType);
+      };
+
       //Load From File
-      auto childNodes = texturingNode->GetChildrenNodes();
       int textureCount = 0;
 
       int currentlayerindex = 0;
-      for (auto child : childNodes)
+      for (const FWCManifestSplatmap& splatmap : manifest->splatmaps)
       {
-        auto textures = child->GetChildrenNodes();
+        const TArray<FWCManifestLayer>& textures = splatmap.layers;
         for (int i = 0; i < textures.Num(); i++)
         {
-          FString texturename = XmlHelper::GetString(textures[i], "Name");
-          float tilescaleX;
-          float tilescaleY;
-          float tileoffsetX;
-          float tileoffsetY;
-          XmlHelper::GetFloat2(textures[i], "TileSize", &tilescaleX, &tilescaleY);
-          XmlHelper::GetFloat2(textures[i], "TileOffset", &tileoffsetX, &tileoffsetY);
-          tilescaleX = mappingLength / tilescaleX;
-          tilescaleY = mappingWidth / tilescaleY;
-          tileoffsetX /= mappingLength;
-          tileoffsetY /= mappingWidth;
+          const FWCManifestLayer& textureLayer = textures[i];
+          const FString& texturename = textureLayer.name;
 
           FLayerBlendInput albedoLayerBlendInput;
           albedoLayerBlendInput.LayerName = FName(*FString::Printf(TEXT("%d: %s"), textureCount, texturename.GetCharArray().GetData())); // FString::Printf(TEXT("Texture%d"), textureCount).GetCharArray().GetData();
@@ -1709,51 +2165,29 @@ UMaterial* FWorldCreatorBridgeModule::CreateLandscapeMaterial(int terrainId, int
           RoughnessLayerBlend->Layers.Add(roughnessLayerBlendInput);
           RoughnessLayerBlend->GetInput(currentlayerindex)->Expression = emptyRoughnessVectorParam;
 
+          UMaterialExpression* vectorParam = graph.VectorParameter(FName(FString::Printf(TEXT("Color%d"), textureCount)), textureLayer.color);
 
-          auto textureNode = textures[i];
-
-          FString colorAtt = textureNode->GetAttribute(TEXT("Color")).GetCharArray().GetData();
+          // (landscape coords + offset) / tile size, the same for every landscape of the terrain. Layers with the same
+          // tiling share the coordinates
+          UMaterialExpression* layerUV = graph.Multiply(graph.Add(graph.Constant2(textureLayer.tileOffset.X, textureLayer.tileOffset.Y), LandscapeCoords),
+            graph.Constant2(1.0f / textureLayer.tileSize.X, 1.0f / textureLayer.tileSize.Y));
 
-          colorAtt.RemoveFromStart(TEXT("#ff"));
-          FLinearColor color = FLinearColor(FColor::FromHex(colorAtt));
-
-
-          UMaterialExpressionVectorParameter* vectorParam = NewObject<UMaterialExpressionVectorParameter>(material);
-          vectorParam->ParameterName = FName(FString::Printf(TEXT("Color%d"), textureCount));
-          expressionCollection->AddExpression(vectorParam);
-          material->SetVectorParameterValueEditorOnly(FString::Printf(TEXT("Color%d"), textureCount).GetCharArray().GetData(), color);
-
-          auto connectTextureLambda = [expressionCollection, material, fittetLandscapeCoord, vectorParam, tilescaleX, tilescaleY, tileoffsetX, tileoffsetY](UTexture2D* currentTexture)
-            {
-              UMaterialExpressionTextureSample* currentExpression = NewObject<UMaterialExpressionTextureSample>(material);
-              currentExpression->Texture = currentTexture;
-              expressionCollection->Expressions.Add(currentExpression);
-              UMaterialExpressionMultiply* multExp = NewObject<UMaterialExpressionMultiply>(material);
-              UMaterialExpressionConstant2Vector* vec2Exp = NewObject<UMaterialExpressionConstant2Vector>(material);
-              UMaterialExpressionConstant2Vector* vec2off = NewObject<UMaterialExpressionConstant2Vector>(material);
-              expressionCollection->Expressions.Add(multExp);
-              expressionCollection->Expressions.Add(vec2Exp);
-              expressionCollection->Expressions.Add(vec2off);
-              vec2Exp->R = tilescaleX;
-              vec2Exp->G = tilescaleY;
-              vec2off->R = tileoffsetX;
-              vec2off->G = tileoffsetY;
-              UMaterialExpressionAdd* offsetLandscapeCoords = NewObject<UMaterialExpressionAdd>(material);
-              offsetLandscapeCoords->A.Expression = vec2off;
-              offsetLandscapeCoords->B.Expression = fittetLandscapeCoord;
-              expressionCollection->Expressions.Add(offsetLandscapeCoords);
-              multExp->A.Expression = offsetLandscapeCoords;
-              multExp->B.Expression = vec2Exp;
-              currentExpression->Coordinates.Expression = multExp;
-              return currentExpression;
-            };
+          // one sample of the packed texture replaces the ao, roughness and displacement samples
+          UTexture2D* packedTex = bPackLayerTextures ? FindPackedLayerTexture(textureCount) : nullptr;
+          if (packedTex)
+          {
+            UMaterialExpression* packedSample = sampleLayerMap(LAYER_MAP_PACKED, packedTex, layerUV, SAMPLERTYPE_Masks);
+            AOLayerBlend->GetInput(currentlayerindex)->Expression = graph.Mask(packedSample, true, false);
+            RoughnessLayerBlend->GetInput(currentlayerindex)->Expression = graph.Mask(packedSample, false, true);
+            DisplacementLayerBlend->GetInput(currentlayerindex)->Expression = graph.Mask(packedSample, false, false, true);
+          }
 
           TArray<FString> TexturePaths;
-          auto albedoFile = textureNode->GetAttribute(TEXT("AlbedoFile"));
-          auto normalFile = textureNode->GetAttribute(TEXT("NormalFile"));
-          auto aoFile = textureNode->GetAttribute(TEXT("AoFile"));
-          auto displacementFile = textureNode->GetAttribute(TEXT("DisplacementFile"));
-          auto roughnessFile = textureNode->GetAttribute(TEXT("RoughnessFile"));
+          FString albedoFile = textureLayer.albedoFile;
+          FString normalFile = textureLayer.normalFile;
+          FString aoFile = textureLayer.aoFile;
+          FString displacementFile = textureLayer.displacementFile;
+          FString roughnessFile = textureLayer.roughnessFile;
 
           // has to be done this way because FFileManagerGeneric::FileExists does not work
           if (!albedoFile.IsEmpty())
@@ -1763,13 +2197,7 @@ UMaterial* FWorldCreatorBridgeModule::CreateLandscapeMaterial(int terrainId, int
             FSoftObjectPath currentAssetPath(FString::Printf(TEXT("%s%s"), MATERIAL_PACKAGE_NAME_PREFIX.GetCharArray().GetData(), albedoFile.GetCharArray().GetData()));
             UTexture2D* currentTex = Cast<UTexture2D>(currentAssetPath.TryLoad());
             if (currentTex)
-            {
-              UMaterialExpressionMultiply* multEx = NewObject<UMaterialExpressionMultiply>(material);
-              multEx->A.Expression = connectTextureLambda(currentTex);
-              multEx->B.Expression = vectorParam;
-
-              AlbedoLayerBlend->GetInput(currentlayerindex)->Expression = multEx;
-            }
+              AlbedoLayerBlend->GetInput(currentlayerindex)->Expression = graph.Multiply(sampleLayerMap(LAYER_MAP_ALBEDO, currentTex, layerUV, SAMPLERTYPE_Color), vectorParam);
           }
           if (!normalFile.IsEmpty())
           {
@@ -1781,41 +2209,35 @@ UMaterial* FWorldCreatorBridgeModule::CreateLandscapeMaterial(int terrainId, int
             {
               currentTex->SRGB = 0;
               currentTex->CompressionSettings = TC_Normalmap;
-              auto ne = connectTextureLambda(currentTex);
-              NormalLayerBlend->GetInput(currentlayerindex)->Expression = ne;
-              ne->SamplerType = SAMPLERTYPE_Normal;
+              NormalLayerBlend->GetInput(currentlayerindex)->Expression = sampleLayerMap(LAYER_MAP_NORMAL, currentTex, layerUV, SAMPLERTYPE_Normal);
             }
           }
-          if (!aoFile.IsEmpty())
+          if (packedTex == nullptr && !aoFile.IsEmpty())
           {
             aoFile.RemoveFromEnd(FString::Printf(TEXT(".%s"), COLORMAP_FILEENDING));
             aoFile.RemoveFromEnd(FString::Printf(TEXT(".%s"), COLORMAP_FILEENDING_2));
             FSoftObjectPath currentAssetPath(FString::Printf(TEXT("%s%s"), MATERIAL_PACKAGE_NAME_PREFIX.GetCharArray().GetData(), aoFile.GetCharArray().GetData()));
             UTexture2D* currentTex = Cast<UTexture2D>(currentAssetPath.TryLoad());
             if (currentTex)
-              AOLayerBlend->GetInput(currentlayerindex)->Expression = connectTextureLambda(currentTex);
+              AOLayerBlend->GetInput(currentlayerindex)->Expression = sampleLayerMap(LAYER_MAP_AO, currentTex, layerUV, SAMPLERTYPE_Color);
           }
-          if (!displacementFile.IsEmpty())
+          if (packedTex == nullptr && !displacementFile.IsEmpty())
           {
             displacementFile.RemoveFromEnd(FString::Printf(TEXT(".%s"), COLORMAP_FILEENDING));
             displacementFile.RemoveFromEnd(FString::Printf(TEXT(".%s"), COLORMAP_FILEENDING_2));
             FSoftObjectPath currentAssetPath(FString::Printf(TEXT("%s%s"), MATERIAL_PACKAGE_NAME_PREFIX.GetCharArray().GetData(), displacementFile.GetCharArray().GetData()));
             UTexture2D* currentTex = Cast<UTexture2D>(currentAssetPath.TryLoad());
             if (currentTex)
-            {
-              UMaterialExpressionTextureSample* nd = connectTextureLambda(currentTex);
-              nd->SamplerType = SAMPLERTYPE_LinearColor;
-              DisplacementLayerBlend->GetInput(currentlayerindex)->Expression = nd;
-            }
+              DisplacementLayerBlend->GetInput(currentlayerindex)->Expression = sampleLayerMap(LAYER_MAP_DISPLACEMENT, currentTex, layerUV, SAMPLERTYPE_LinearColor);
           }
-          if (!roughnessFile.IsEmpty())
+          if (packedTex == nullptr && !roughnessFile.IsEmpty())
           {
             roughnessFile.RemoveFromEnd(FString::Printf(TEXT(".%s"), COLORMAP_FILEENDING));
             roughnessFile.RemoveFromEnd(FString::Printf(TEXT(".%s"), COLORMAP_FILEENDING_2));
             FSoftObjectPath currentAssetPath(FString::Printf(TEXT("%s%s"), MATERIAL_PACKAGE_NAME_PREFIX.GetCharArray().GetData(), roughnessFile.GetCharArray().GetData()));
             UTexture2D* currentTex = Cast<UTexture2D>(currentAssetPath.TryLoad());
             if (currentTex)
-              RoughnessLayerBlend->GetInput(currentlayerindex)->Expression = connectTextureLambda(currentTex);
+              RoughnessLayerBlend->GetInput(currentlayerindex)->Expression = sampleLayerMap(LAYER_MAP_ROUGHNESS, currentTex, layerUV, SAMPLERTYPE_Color);
           }
 
           textureCount++;
@@ -1835,37 +2257,276 @@ UMaterial* FWorldCreatorBridgeModule::CreateLandscapeMaterial(int terrainId, int
 
   //// Assign Color Expressions to result node
   /////////////////////////////////////////////////
-  material->AssignExpressionCollection(*expressionCollection);
   material->GetEditorOnlyData()->BaseColor.Expression = AlbedoLayerBlend;
   material->GetEditorOnlyData()->Normal.Expression = NormalLayerBlend;
   material->GetEditorOnlyData()->AmbientOcclusion.Expression = AOLayerBlend;
   material->GetEditorOnlyData()->WorldPositionOffset.Expression = DisplacementLayerBlend;
   material->GetEditorOnlyData()->Roughness.Expression = RoughnessLayerBlend;
-
-  expressioncopy = material->GetExpressionCollection().Expressions;
-  for (UMaterialExpression* v : expressioncopy)
-  {
-    if (!v->HasConnectedOutputs())
-      material->GetExpressionCollection().RemoveExpression(v);
-  }
-  expressioncopy.Empty();
+  graph.Finish({ AlbedoLayerBlend, NormalLayerBlend, AOLayerBlend, DisplacementLayerBlend, RoughnessLayerBlend });
 
   material->PreEditChange(NULL);
   material->PostEditChange();
-  // make sure that any static meshes, etc using this material will stop using the FMaterialResource of the original
-  // material, and will use the new FMaterialResource created when we make a new UMaterial in place
-  FGlobalComponentReregisterContext RecreateComponents;
+  materialPackage->GetMetaData()->SetValue(material, MATERIAL_GRAPH_HASH_KEY, *graphHash);
   return material;
 }
 
+uint64 FWorldCreatorBridgeModule::GetMaterialGraphHash(int slotsX, int slotsY) const
+{
+  // everything CreateParentMaterial builds the graph from, the mapping and tile offsets of the landscapes are
+  // parameters of their instances
+  FXxHash64Builder builder;
+  const uint64 layerHash = manifest->GetLayerHash();
+  builder.Update(&layerHash, sizeof(layerHash));
+  const bool bColormapArray = colormapArray.IsValid();
+  int layerArrayMask = 0;
+  for (int layerMap = 0; bLayerTextureArrays && layerMap < LAYER_MAP_COUNT; layerMap++)
+  {
+    if (LoadLayerArray(layerMap) != nullptr)
+      layerArrayMask |= 1 << layerMap;
+  }
+  const int settings[] = { MATERIAL_GRAPH_VERSION, version, bImportLayers, bImportTextures, bPackLayerTextures, layerArrayMask, slotsX, slotsY, bColormapArray,
+    bColormapArray ? numTilesX : 0, bColormapArray ? numTilesY : 0, tileResolution, width, length };
+  builder.Update(settings, sizeof(settings));
 
-void FWorldCreatorBridgeModule::ImportTextureFiles()
+  // the graph only samples the layer textures that load, a texture that failed to import in the last sync has to
+  // change the hash once it is there
+  if (bImportLayers && manifest->bHasTexturing)
+  {
+    int layerIndex = 0;
+    for (const FWCManifestSplatmap& splatmap : manifest->splatmaps)
+    {
+      for (const FWCManifestLayer& textureLayer : splatmap.layers)
+      {
+        for (int layerMap = 0; layerMap < LAYER_MAP_COUNT; layerMap++)
+        {
+          const UTexture2D* texture = layerMap != LAYER_MAP_PACKED || bPackLayerTextures ? LoadLayerMap(textureLayer, layerIndex, layerMap) : nullptr;
+          const FString texturePath = texture != nullptr ? texture->GetPathName() : FString();
+          builder.Update(*texturePath, (texturePath.Len() + 1) * sizeof(TCHAR));
+        }
+        layerIndex++;
+      }
+    }
+  }
+  return builder.Finalize().Hash;
+}
+
+UMaterialInterface* FWorldCreatorBridgeModule::CreateLandscapeMaterial(int terrainId, int _numTilesX, int _numTilesY, int startX, int startY, int mappingWidth, int mappingLength)
 {
-  syncDir = FPaths::GetPath(selectedPath);
-  FXmlFile configFile(selectedPath);
-  root = configFile.GetRootNode();
-  auto texturingNode = root->FindChildNode(TEXT("Texturing"));
+  // the graph is only built and compiled once per sync, the landscapes get instances that set the parameters of
+  // the colormap tiles they cover
+  if (!parentMaterial.IsValid())
+  {
+    // with all colormap tiles in one texture array the parent samples them once and needs no slots
+    colormapArray = LoadColormapArray();
+    if (colormapArray.IsValid())
+      parentMaterial = CreateParentMaterial(0, 0);
+  }
+  if (!colormapArray.IsValid() && (!parentMaterial.IsValid() || _numTilesX > parentMaterialSlots.X || _numTilesY > parentMaterialSlots.Y))
+  {
+    // a landscape can start anywhere in a tile, so it may touch one tile more than its size needs
+    FIntPoint slots(1, 1);
+    if (version >= 3 && tileResolution > 0)
+    {
+      const int maxSlots = (unrealTerrainResolution - 2) / tileResolution + 2;
+      slots.X = numTilesX > 0 ? FMath::Min(maxSlots, numTilesX) : maxSlots;
+      slots.Y = numTilesY > 0 ? FMath::Min(maxSlots, numTilesY) : maxSlots;
+    }
+    parentMaterialSlots.X = FMath::Max3(slots.X, _numTilesX, parentMaterialSlots.X);
+    parentMaterialSlots.Y = FMath::Max3(slots.Y, _numTilesY, parentMaterialSlots.Y);
+    parentMaterial = CreateParentMaterial(parentMaterialSlots.X, parentMaterialSlots.Y);
+  }
 
+  const FString instanceName = FString::Printf(TEXT("%s_%d"), *terrainMaterialName, terrainId);
+  UPackage* instancePackage = CreatePackage(*(MATERIAL_PACKAGE_NAME_PREFIX + instanceName));
+  instancePackage->FullyLoad();
+  UMaterialInstanceConstant* instance = FindObject<UMaterialInstanceConstant>(instancePackage, *instanceName);
+  if (instance == nullptr)
+  {
+    instance = NewObject<UMaterialInstanceConstant>(instancePackage, *instanceName, RF_Public | RF_Standalone | RF_Transactional);
+    FAssetRegistryModule::AssetCreated(instance);
+  }
+  instance->SetParentEditorOnly(parentMaterial.Get());
+  instance->ClearParameterValuesEditorOnly();
+  instance->SetScalarParameterValueEditorOnly(FMaterialParameterInfo(MAPPING_WIDTH_PARAMETER), mappingWidth);
+  instance->SetScalarParameterValueEditorOnly(FMaterialParameterInfo(MAPPING_LENGTH_PARAMETER), mappingLength);
+  instance->SetVectorParameterValueEditorOnly(FMaterialParameterInfo(LANDSCAPE_ORIGIN_PARAMETER), FLinearColor(startY, startX, 0.0f, 0.0f));
+  if (colormapArray.IsValid())
+  {
+    instance->PostEditChange();
+    instancePackage->SetDirtyFlag(true);
+    return instance;
+  }
+
+  const int startTileX = startX / tileResolution;
+  const int startTileY = startY / tileResolution;
+  const FString baseMapName = bImportLayers ? COLORMAP_NAME : TEXTUREMAP_NAME;
+  for (int x = 0; x < _numTilesX; x++)
+  {
+    for (int y = 0; y < _numTilesY; y++)
+    {
+      FString diffuseAssetPath;
+      if (version >= 3)
+      {
+        diffuseAssetPath = FString::Printf(TEXT("%s%s_%d_%d"), *MATERIAL_PACKAGE_NAME_PREFIX, *baseMapName, x + startTileX, y + startTileY);
+      }
+      else
+      {
+        diffuseAssetPath = FString::Printf(TEXT("%s%s"), *MATERIAL_PACKAGE_NAME_PREFIX, *baseMapName);
+      }
+
+      const FLinearColor offset(startY % tileResolution - (mappingLength * y), startX % tileResolution - (mappingWidth * x), 0.0f, 0.0f);
+      instance->SetVectorParameterValueEditorOnly(FMaterialParameterInfo(GetColormapSlotParameter(COLORMAP_OFFSET_PARAMETER, x, y)), offset);
+      UTexture* diffuseTexture = Cast<UTexture>(FSoftObjectPath(diffuseAssetPath).TryLoad());
+      if (diffuseTexture != nullptr)
+      {
+        instance->SetTextureParameterValueEditorOnly(FMaterialParameterInfo(GetColormapSlotParameter(COLORMAP_TEXTURE_PARAMETER, x, y)), diffuseTexture);
+      }
+    }
+  }
+
+  // parameter changes only update the uniform values of the parent's shaders
+  instance->PostEditChange();
+  instancePackage->SetDirtyFlag(true);
+  return instance;
+}
+
+FString FWorldCreatorBridgeModule::GetColormapArrayName() const
+{
+  return FString::Printf(TEXT("%s_array"), bImportLayers ? *COLORMAP_NAME : *TEXTUREMAP_NAME);
+}
+
+UTexture2DArray* FWorldCreatorBridgeModule::LoadColormapArray() const
+{
+  const FString arrayName = GetColormapArrayName();
+  UTexture2DArray* textureArray = LoadObject<UTexture2DArray>(nullptr, *FString::Printf(TEXT("%s%s.%s"), *MATERIAL_PACKAGE_NAME_PREFIX, *arrayName, *arrayName), nullptr, LOAD_NoWarn | LOAD_Quiet);
+  // an array of a sync with a different tile layout or of colormaps with a different size or format is not used
+  TArray<TObjectPtr<UTexture2D>> sourceTextures;
+  if (textureArray == nullptr || !LoadColormapTiles(sourceTextures) || !IsTextureArrayCurrent(textureArray, sourceTextures))
+    return nullptr;
+  return textureArray;
+}
+
+bool FWorldCreatorBridgeModule::LoadColormapTiles(TArray<TObjectPtr<UTexture2D>>& outTextures) const
+{
+  // slice y * tilesX + x holds the colormap of tile x, y
+  const FString baseMapName = bImportLayers ? COLORMAP_NAME : TEXTUREMAP_NAME;
+  const int arrayTilesX = version >= 3 ? FMath::Max(1, numTilesX) : 1;
+  const int arrayTilesY = version >= 3 ? FMath::Max(1, numTilesY) : 1;
+  for (int y = 0; y < arrayTilesY; y++)
+  {
+    for (int x = 0; x < arrayTilesX; x++)
+    {
+      FString texturePath;
+      if (version >= 3)
+        texturePath = FString::Printf(TEXT("%s%s_%d_%d"), *MATERIAL_PACKAGE_NAME_PREFIX, *baseMapName, x, y);
+      else
+        texturePath = FString::Printf(TEXT("%s%s"), *MATERIAL_PACKAGE_NAME_PREFIX, *baseMapName);
+
+      UTexture2D* texture = Cast<UTexture2D>(FSoftObjectPath(texturePath).TryLoad());
+      if (texture == nullptr)
+        return false;
+      outTextures.Add(texture);
+    }
+  }
+  return true;
+}
+
+bool FWorldCreatorBridgeModule::IsTextureArrayCurrent(const UTexture2DArray* textureArray, const TArray<TObjectPtr<UTexture2D>>& sourceTextures)
+{
+  // every slice has to come from its texture, and the textures must still have the size and format of the slices
+  if (textureArray == nullptr || textureArray->SourceTextures != sourceTextures || textureArray->Source.GetNumSlices() != sourceTextures.Num())
+    return false;
+  for (const UTexture2D* texture : sourceTextures)
+  {
+    if (texture == nullptr || texture->Source.GetSizeX() != textureArray->Source.GetSizeX() || texture->Source.GetSizeY() != textureArray->Source.GetSizeY()
+      || texture->Source.GetFormat() != textureArray->Source.GetFormat())
+      return false;
+  }
+  return true;
+}
+
+UTexture2DArray* FWorldCreatorBridgeModule::CreateColormapArray()
+{
+  // all tiles need the same size and format, otherwise the landscape material falls back to sampling the tiles one
+  // by one
+  const int numSlices = version >= 3 ? FMath::Max(1, numTilesX) * FMath::Max(1, numTilesY) : 1;
+  if (numSlices > GMaxTextureArrayLayers)
+  {
+    UE_LOG(LogTemp, Warning, TEXT("%d colormap tiles do not fit into a texture array, the landscape material samples them one by one"), numSlices);
+    return nullptr;
+  }
+
+  TArray<TObjectPtr<UTexture2D>> sourceTextures;
+  if (!LoadColormapTiles(sourceTextures))
+    return nullptr;
+  for (const UTexture2D* texture : sourceTextures)
+  {
+    if (texture->Source.GetSizeX() != sourceTextures[0]->Source.GetSizeX() || texture->Source.GetSizeY() != sourceTextures[0]->Source.GetSizeY()
+      || texture->Source.GetFormat() != sourceTextures[0]->Source.GetFormat())
+    {
+      UE_LOG(LogTemp, Warning, TEXT("%s does not match the other colormap tiles, the landscape material samples them one by one"), *texture->GetPathName());
+      return nullptr;
+    }
+  }
+
+  return CreateTextureArray(GetColormapArrayName(), sourceTextures);
+}
+
+UTexture2DArray* FWorldCreatorBridgeModule::CreateTextureArray(const FString& arrayName, const TArray<TObjectPtr<UTexture2D>>& sourceTextures)
+{
+  UPackage* arrayPackage = CreatePackage(*(MATERIAL_PACKAGE_NAME_PREFIX + arrayName));
+  arrayPackage->FullyLoad();
+  UTexture2DArray* textureArray = FindObject<UTexture2DArray>(arrayPackage, *arrayName);
+  const bool bCreated = textureArray == nullptr;
+  if (bCreated)
+    textureArray = NewObject<UTexture2DArray>(arrayPackage, *arrayName, RF_Public | RF_Standalone | RF_Transactional);
+
+  textureArray->SourceTextures = sourceTextures;
+  textureArray->SRGB = sourceTextures[0]->SRGB;
+  textureArray->CompressionSettings = sourceTextures[0]->CompressionSettings;
+  textureArray->UpdateSourceFromSourceTextures(bCreated);
+  textureArray->PostEditChange();
+  arrayPackage->SetDirtyFlag(true);
+  if (bCreated)
+    FAssetRegistryModule::AssetCreated(textureArray);
+  return textureArray;
+}
+
+UMaterialExpression* FWorldCreatorBridgeModule::CreateColormapArraySample(FWCMaterialGraphBuilder& graph, UMaterialExpression* landscapeCoords, UTexture2DArray* textureArray)
+{
+  // terrain position -> tile index and position inside the tile, R is the y and G the x axis of the terrain like in
+  // the landscape coords. Border tiles are smaller than the tile resolution.
+  const int arrayTilesX = version >= 3 ? FMath::Max(1, numTilesX) : 1;
+  const int arrayTilesY = version >= 3 ? FMath::Max(1, numTilesY) : 1;
+  UMaterialExpression* terrainCoords = graph.Add(landscapeCoords, graph.Mask(graph.VectorParameter(LANDSCAPE_ORIGIN_PARAMETER, FLinearColor::Black), true, true));
+  UMaterialExpression* tileSize = version >= 3 ? graph.Constant2(tileResolution, tileResolution) : graph.Constant2(length, width);
+  UMaterialExpression* terrainSize = graph.Constant2(length, width);
+
+  // the last row of vertices lies on the far border of the last tile
+  UMaterialExpression* tileIndex = graph.Min(graph.Floor(graph.Divide(terrainCoords, tileSize)), graph.Constant2(arrayTilesY - 1, arrayTilesX - 1));
+  UMaterialExpression* tileStart = graph.Multiply(tileIndex, tileSize);
+  UMaterialExpression* tileExtent = graph.Min(tileSize, graph.Subtract(terrainSize, tileStart));
+  UMaterialExpression* tileUV = graph.Divide(graph.Subtract(terrainCoords, tileStart), tileExtent);
+
+  // u runs along the terrain's x axis, v is flipped along its y axis
+  UMaterialExpression* uv = graph.Append(graph.Mask(tileUV, false, true), graph.OneMinus(graph.Mask(tileUV, true, false)));
+  UMaterialExpression* slice = graph.Add(graph.Multiply(graph.Mask(tileIndex, true, false), graph.Constant(arrayTilesX)), graph.Mask(tileIndex, false, true));
+
+  // the uv restarts at every tile border, its own derivatives would select the smallest mip along the border. The
+  // derivatives of the continuous terrain coords, scaled to the tile, select the mip without the jump
+  UMaterialExpression* uvScale = graph.Append(graph.Divide(graph.Constant(1.0f), graph.Mask(tileExtent, false, true)),
+    graph.Divide(graph.Constant(-1.0f), graph.Mask(tileExtent, true, false)));
+  UMaterialExpression* terrainDX = graph.DDX(terrainCoords);
+  UMaterialExpression* terrainDY = graph.DDY(terrainCoords);
+  UMaterialExpression* uvDX = graph.Multiply(graph.Append(graph.Mask(terrainDX, false, true), graph.Mask(terrainDX, true, false)), uvScale);
+  UMaterialExpression* uvDY = graph.Multiply(graph.Append(graph.Mask(terrainDY, false, true), graph.Mask(terrainDY, true, false)), uvScale);
+  return graph.TextureSampleGrad(textureArray, graph.Append(uv, slice), uvDX, uvDY, SAMPLERTYPE_Color);
+}
+
+void FWorldCreatorBridgeModule::ImportTextureFiles(const FWCSyncState* previousSyncState, FWCSyncState* syncState)
+{
+  TRACE_CPUPROFILER_EVENT_SCOPE(FWorldCreatorBridgeModule::ImportTextureFiles);
+  FWCSyncStats::FScopedStage stage(syncStats, EWCSyncStage::TextureImport);
 
   TArray<FString> colormapPaths;
   TArray<FString> colormapPathsCopy;
@@ -1890,30 +2551,29 @@ void FWorldCreatorBridgeModule::ImportTextureFiles()
     TexturePaths.Add(FString::Printf(TEXT("%s/%s"), syncDir.GetCharArray().GetData(), name.GetCharArray().GetData()));
   }
 
-  if (texturingNode != nullptr && bImportLayers)
+  if (manifest->bHasTexturing && bImportLayers)
   {
     //Load From File
-    auto childNodes = texturingNode->GetChildrenNodes();
     int textureCount = 0;
 
     int currentlayerindex = 0;
-    for (auto child : childNodes)
+    for (const FWCManifestSplatmap& splatmap : manifest->splatmaps)
     {
-      auto textures = child->GetChildrenNodes();
+      const TArray<FWCManifestLayer>& textures = splatmap.layers;
 
 
       for (int i = 0; i < textures.Num(); i++)
       {
 
-        auto textureNode = textures[i];
+        const FWCManifestLayer& textureLayer = textures[i];
 
         // Import Textures 
         TArray<FString> TexturePathNames;
-        auto albedoFile = textureNode->GetAttribute(TEXT("AlbedoFile"));
-        auto normalFile = textureNode->GetAttribute(TEXT("NormalFile"));
-        auto aoFile = textureNode->GetAttribute(TEXT("AoFile"));
-        auto displacementFile = textureNode->GetAttribute(TEXT("DisplacementFile"));
-        auto roughnessFile = textureNode->GetAttribute(TEXT("RoughnessFile"));
+        FString albedoFile = textureLayer.albedoFile;
+        FString normalFile = textureLayer.normalFile;
+        FString aoFile = textureLayer.aoFile;
+        FString displacementFile = textureLayer.displacementFile;
+        FString roughnessFile = textureLayer.roughnessFile;
 
         // has to be done this way because FFileManagerGeneric::FileExists does not work
 
@@ -1990,6 +2650,35 @@ void FWorldCreatorBridgeModule::ImportTextureFiles()
     }
   }
 
+  // the textures are only imported again if one of the files changed since the last sync
+  // syncs that do not keep their state import the textures without hashing them
+  bool bTexturesChanged = previousSyncState == nullptr || syncState == nullptr || previousSyncState->textureHashes.Num() != TexturePaths.Num();
+  for (int i = 0; i < TexturePaths.Num() && syncState != nullptr; i++)
+  {
+    const FString& texturePath = TexturePaths[i];
+    // a file that cannot be read is not recorded, so the next sync imports the textures again as well
+    uint64 textureHash;
+    if (!FWCSyncState::HashFile(texturePath, textureHash))
+    {
+      bTexturesChanged = true;
+      continue;
+    }
+    syncState->textureHashes.Add(texturePath, textureHash);
+    const uint64* previousHash = previousSyncState != nullptr ? previousSyncState->textureHashes.Find(texturePath) : nullptr;
+    bTexturesChanged |= previousHash == nullptr || *previousHash != textureHash;
+  }
+  if (!bTexturesChanged)
+  {
+    // the colormaps of the previous sync are kept, the array is only built if it is missing
+    if (LoadColormapArray() == nullptr)
+      CreateColormapArray();
+    if (bPackLayerTextures && bImportLayers && manifest->bHasTexturing)
+      PackLayerTextures(false);
+    if (bLayerTextureArrays && bImportLayers && manifest->bHasTexturing)
+      CreateLayerArrays(false);
+    return;
+  }
+
   UAutomatedAssetImportData* TextureImportData = NewObject<UAutomatedAssetImportData>();
   FAssetRegistryModule::AssetCreated(TextureImportData);
   TextureImportData->bReplaceExisting = true;
@@ -2003,112 +2692,461 @@ void FWorldCreatorBridgeModule::ImportTextureFiles()
     obj->MarkPackageDirty();
     FAssetRegistryModule::AssetCreated(obj);
   }
-
-  configFile.Clear();
+  CreateColormapArray();
+  if (bPackLayerTextures && bImportLayers && manifest->bHasTexturing)
+    PackLayerTextures(true);
+  if (bLayerTextureArrays && bImportLayers && manifest->bHasTexturing)
+    CreateLayerArrays(true);
+}
+
+UTexture2D* FWorldCreatorBridgeModule::LoadLayerTexture(FString fileName) const
+{
+  fileName.RemoveFromEnd(FString::Printf(TEXT(".%s"), COLORMAP_FILEENDING));
+  fileName.RemoveFromEnd(FString::Printf(TEXT(".%s"), COLORMAP_FILEENDING_2));
+  FSoftObjectPath assetPath(MATERIAL_PACKAGE_NAME_PREFIX + fileName);
+  return Cast<UTexture2D>(assetPath.TryLoad());
+}
+
+FString FWorldCreatorBridgeModule::GetPackedLayerTextureName(int layerIndex) const
+{
+  return FString::Printf(TEXT("%s_packed_%d"), *terrainName, layerIndex);
+}
+
+UTexture2D* FWorldCreatorBridgeModule::FindPackedLayerTexture(int layerIndex) const
+{
+  const FString packedName = GetPackedLayerTextureName(layerIndex);
+  return LoadObject<UTexture2D>(nullptr, *FString::Printf(TEXT("%s%s.%s"), *MATERIAL_PACKAGE_NAME_PREFIX, *packedName, *packedName), nullptr, LOAD_NoWarn | LOAD_Quiet);
+}
+
+void FWorldCreatorBridgeModule::PackLayerTextures(bool bForce)
+{
+  // R ambient occlusion, G roughness, B displacement. Missing maps are filled with the values of the empty layer
+  // inputs of the material, maps of different size are resized to the largest one
+  static const uint8 CHANNEL_DEFAULTS[3] = { 255, 255, 0 };
+  TSet<FString> packedNames;
+  int layerIndex = 0;
+  for (const FWCManifestSplatmap& splatmap : manifest->splatmaps)
+  {
+    for (const FWCManifestLayer& textureLayer : splatmap.layers)
+    {
+      // a packed texture is kept if it was packed from the same files, layers that were reordered or inserted
+      // have other files at their index
+      const FString packedName = GetPackedLayerTextureName(layerIndex);
+      const FString packedSources = FString::Join(TArray<FString>({ textureLayer.aoFile, textureLayer.roughnessFile, textureLayer.displacementFile }), TEXT("|"));
+      UTexture2D* existingTexture = FindPackedLayerTexture(layerIndex++);
+      if (!bForce && existingTexture != nullptr && existingTexture->GetOutermost()->GetMetaData()->GetValue(existingTexture, PACKED_SOURCES_KEY) == packedSources)
+      {
+        packedNames.Add(packedName);
+        continue;
+      }
+
+      const FString channelFiles[3] = { textureLayer.aoFile, textureLayer.roughnessFile, textureLayer.displacementFile };
+      FImage channelImages[3];
+      int sizeX = 0;
+      int sizeY = 0;
+      for (int c = 0; c < 3; c++)
+      {
+        UTexture2D* texture = channelFiles[c].IsEmpty() ? nullptr : LoadLayerTexture(channelFiles[c]);
+        if (texture != nullptr && texture->Source.IsValid() && texture->Source.GetMipImage(channelImages[c], 0, 0, 0))
+        {
+          sizeX = FMath::Max(sizeX, (int)channelImages[c].SizeX);
+          sizeY = FMath::Max(sizeY, (int)channelImages[c].SizeY);
+        }
+      }
+      if (sizeX == 0 || sizeY == 0)
+        continue;
+
+      const int64 numPixels = (int64)sizeX * sizeY;
+      TArray64<uint8> packed;
+      packed.SetNumUninitialized(numPixels * 4);
+      for (int c = 0; c < 3; c++)
+      {
+        FImage channel;
+        if (channelImages[c].SizeX > 0)
+          channelImages[c].ResizeTo(channel, sizeX, sizeY, ERawImageFormat::G8, EGammaSpace::Linear);
+        const uint8* channelData = channel.RawData.Num() > 0 ? channel.RawData.GetData() : nullptr;
+
+        // BGRA, R is the third byte of a pixel
+        uint8* dest = packed.GetData() + (2 - c);
+        for (int64 i = 0; i < numPixels; i++)
+        {
+          dest[i * 4] = channelData != nullptr ? channelData[i] : CHANNEL_DEFAULTS[c];
+        }
+      }
+      for (int64 i = 0; i < numPixels; i++)
+      {
+        packed[i * 4 + 3] = 255;
+      }
+
+      UPackage* packedPackage = CreatePackage(*(MATERIAL_PACKAGE_NAME_PREFIX + packedName));
+      packedPackage->FullyLoad();
+      UTexture2D* packedTexture = FindObject<UTexture2D>(packedPackage, *packedName);
+      const bool bCreated = packedTexture == nullptr;
+      if (bCreated)
+        packedTexture = NewObject<UTexture2D>(packedPackage, *packedName, RF_Public | RF_Standalone | RF_Transactional);
+
+      packedTexture->Source.Init(sizeX, sizeY, 1, 1, TSF_BGRA8, packed.GetData());
+      packedTexture->SRGB = false;
+      packedTexture->CompressionSettings = TC_Masks;
+      packedTexture->PostEditChange();
+      packedPackage->GetMetaData()->SetValue(packedTexture, PACKED_SOURCES_KEY, *packedSources);
+      packedPackage->SetDirtyFlag(true);
+      if (bCreated)
+        FAssetRegistryModule::AssetCreated(packedTexture);
+      packedNames.Add(packedName);
+    }
+  }
+
+  // packed textures of layers that were removed or lost their maps would still be sampled by their index
+  const FString packedPrefix = FString::Printf(TEXT("%s_packed_"), *terrainName);
+  TArray<FAssetData> assets;
+  IAssetRegistry& assetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+  assetRegistry.GetAssetsByPath(FName(*MATERIAL_PACKAGE_NAME_PREFIX.LeftChop(1)), assets);
+  for (const FAssetData& asset : assets)
+  {
+    const FString assetName = asset.AssetName.ToString();
+    if (!assetName.StartsWith(packedPrefix) || !assetName.RightChop(packedPrefix.Len()).IsNumeric() || packedNames.Contains(assetName))
+      continue;
+    if (UObject* stalePackedTexture = asset.GetAsset())
+    {
+      // the parent material of the last sync still references it, the material is built again without it
+      ObjectTools::DeleteSingleObject(stalePackedTexture, false);
+    }
+  }
+}
+
+UTexture2D* FWorldCreatorBridgeModule::LoadLayerMap(const FWCManifestLayer& textureLayer, int layerIndex, int layerMap) const
+{
+  FString fileName;
+  switch (layerMap)
+  {
+  case LAYER_MAP_ALBEDO: fileName = textureLayer.albedoFile; break;
+  case LAYER_MAP_NORMAL: fileName = textureLayer.normalFile; break;
+  case LAYER_MAP_AO: fileName = textureLayer.aoFile; break;
+  case LAYER_MAP_DISPLACEMENT: fileName = textureLayer.displacementFile; break;
+  case LAYER_MAP_ROUGHNESS: fileName = textureLayer.roughnessFile; break;
+  case LAYER_MAP_PACKED: return FindPackedLayerTexture(layerIndex);
+  }
+  return fileName.IsEmpty() ? nullptr : LoadLayerTexture(fileName);
+}
+
+FString FWorldCreatorBridgeModule::GetLayerArrayName(int layerMap) const
+{
+  return FString::Printf(TEXT("%s_%s_array"), *terrainName, LAYER_MAP_NAMES[layerMap]);
+}
+
+UTexture2DArray* FWorldCreatorBridgeModule::FindLayerArray(int layerMap) const
+{
+  const FString arrayName = GetLayerArrayName(layerMap);
+  return LoadObject<UTexture2DArray>(nullptr, *FString::Printf(TEXT("%s%s.%s"), *MATERIAL_PACKAGE_NAME_PREFIX, *arrayName, *arrayName), nullptr, LOAD_NoWarn | LOAD_Quiet);
+}
+
+UTexture2DArray* FWorldCreatorBridgeModule::LoadLayerArray(int layerMap) const
+{
+  // an array whose textures changed size or format since it was built is not used
+  UTexture2DArray* layerArray = FindLayerArray(layerMap);
+  if (layerArray == nullptr || !IsTextureArrayCurrent(layerArray, layerArray->SourceTextures))
+    return nullptr;
+  return layerArray;
+}
+
+bool FWorldCreatorBridgeModule::LoadLayerArrayTextures(int layerMap, TArray<TObjectPtr<UTexture2D>>& outTextures) const
+{
+  // slice n of an array holds the n-th layer that has a texture of the map type. All textures of a map type need the
+  // same size and format, otherwise the landscape material samples them one by one
+  int layerIndex = 0;
+  for (const FWCManifestSplatmap& splatmap : manifest->splatmaps)
+  {
+    for (const FWCManifestLayer& textureLayer : splatmap.layers)
+    {
+      UTexture2D* texture = LoadLayerMap(textureLayer, layerIndex++, layerMap);
+      if (texture == nullptr)
+        continue;
+      if (layerMap == LAYER_MAP_NORMAL)
+      {
+        // same settings the landscape material gives the normal maps
+        texture->SRGB = 0;
+        texture->CompressionSettings = TC_Normalmap;
+      }
+      const UTexture2D* firstTexture = outTextures.Num() > 0 ? outTextures[0].Get() : texture;
+      if (texture->Source.GetSizeX() != firstTexture->Source.GetSizeX() || texture->Source.GetSizeY() != firstTexture->Source.GetSizeY()
+        || texture->Source.GetFormat() != firstTexture->Source.GetFormat())
+      {
+        UE_LOG(LogTemp, Warning, TEXT("%s does not match the other %s textures of the layers, the landscape material samples them one by one"), *texture->GetName(), LAYER_MAP_NAMES[layerMap]);
+        return false;
+      }
+      outTextures.Add(texture);
+    }
+  }
+
+  if (outTextures.Num() > GMaxTextureArrayLayers)
+  {
+    UE_LOG(LogTemp, Warning, TEXT("%d %s textures do not fit into a texture array, the landscape material samples them one by one"), outTextures.Num(), LAYER_MAP_NAMES[layerMap]);
+    return false;
+  }
+  // a single texture takes one sampler either way
+  return outTextures.Num() >= 2;
+}
+
+void FWorldCreatorBridgeModule::CreateLayerArrays(bool bForce)
+{
+  for (int layerMap = 0; layerMap < LAYER_MAP_COUNT; layerMap++)
+  {
+    // the maps in the packed texture are not sampled on their own
+    const bool bPackedMap = layerMap == LAYER_MAP_AO || layerMap == LAYER_MAP_DISPLACEMENT || layerMap == LAYER_MAP_ROUGHNESS;
+    TArray<TObjectPtr<UTexture2D>> sourceTextures;
+    if ((bPackLayerTextures ? bPackedMap : layerMap == LAYER_MAP_PACKED) || !LoadLayerArrayTextures(layerMap, sourceTextures))
+    {
+      // a reimport keeps the texture objects, an array of a previous sync would still match them and be sampled
+      if (UTexture2DArray* staleArray = FindLayerArray(layerMap))
+        ObjectTools::DeleteSingleObject(staleArray, false);
+      continue;
+    }
+
+    // an array that already holds the textures of this sync is kept unless they were imported again
+    const UTexture2DArray* layerArray = bForce ? nullptr : FindLayerArray(layerMap);
+    if (IsTextureArrayCurrent(layerArray, sourceTextures))
+      continue;
+    CreateTextureArray(GetLayerArrayName(layerMap), sourceTextures);
+  }
+}
+
+void FWorldCreatorBridgeModule::DeletePreviousImportedWorldCreatorLandscape(UWorld* world, FVector* location, FRotator* rotation, const TSet<int>* landscapeIds)
+{
+  TRACE_CPUPROFILER_EVENT_SCOPE(FWorldCreatorBridgeModule::DeletePreviousImportedWorldCreatorLandscape);
+  FWCSyncStats::FScopedStage stage(syncStats, EWCSyncStage::Delete);
+  ULevel* level = world->GetCurrentLevel();
+
+
+  //// Find existing landscapes
+  ////////////////////////////
+  // without ids every landscape of the terrain is removed
+  ALandscape* firstLandscape = nullptr;
+  TArray<ALandscape*> landscapeActors;
+  for (auto actorIter = FActorIterator(world); actorIter; ++actorIter)
+  {
+    if (actorIter->GetClass() == ALandscape::StaticClass() && actorIter->GetActorLabel().StartsWith(terrainName))
+    {
+      ALandscape* landscapeActor = (ALandscape*)*actorIter;
+      if (firstLandscape == nullptr)
+        firstLandscape = landscapeActor;
+      if (landscapeIds == nullptr || landscapeIds->Contains(GetImportedLandscapeId(landscapeActor)))
+        landscapeActors.Add(landscapeActor);
+    }
+  }
+  if (firstLandscape == nullptr)
+    return;
+
+  // set the previous location to spawn the new terrain at 
+  *location = firstLandscape->GetActorLocation();
+  *rotation = firstLandscape->GetActorRotation();
+  if (landscapeActors.Num() == 0)
+    return;
+
+  //// Find existing gizmos
+  ////////////////////////
+  for (auto actorIter = FActorIterator(world); actorIter; ++actorIter)
+  {
+    if (actorIter->GetClass() == ALandscapeGizmoActiveActor::StaticClass())
+    {
+      auto gizmo = (ALandscapeGizmoActiveActor*)*actorIter;
+      for (ALandscape* landscapeActor : landscapeActors)
+      {
+        if (gizmo->TargetLandscapeInfo == landscapeActor->GetLandscapeInfo())
+        {
+          gizmo->Destroy();
+          break;
+        }
+      }
+    }
+  }
+
+  if (level)
+  {
+    if (level->bIsPartitioned)
+    {
+      UWorldPartitionEditorLoaderAdapter* EditorLoaderAdapter = world->GetWorldPartition()->CreateEditorLoaderAdapter<FLoaderAdapterShape>(world, REGIONBOX, TEXT("Loaded Region"));
+      EditorLoaderAdapter->GetLoaderAdapter()->SetUserCreated(true);
+      EditorLoaderAdapter->GetLoaderAdapter()->Load();
+
+      SelectedLoaderInterfaces.Empty();
+      SelectedLoaderInterfaces.Add(EditorLoaderAdapter);
+
+      auto actorIterforProxy = FActorIterator(world);
+      ALandscapeStreamingProxy* streamingProxy = nullptr;
+      auto streamProxyClass = ALandscapeStreamingProxy::StaticClass();
+
+      while (actorIterforProxy)
+      {
+        if (actorIterforProxy->GetClass() == streamProxyClass)
+        {
+          streamingProxy = (ALandscapeStreamingProxy*)*actorIterforProxy;
+          if (landscapeActors.Contains(streamingProxy->GetLandscapeActor()))
+          {
+            streamingProxy->Destroy();
+            streamingProxy = nullptr;
+          }
+        }
+        ++actorIterforProxy;
+      }
+
+      EditorLoaderAdapter->GetLoaderAdapter()->Unload();
+      SelectedLoaderInterfaces.Empty();
+    }
+  }
+
+  for (ALandscape* landscapeActor : landscapeActors)
+  {
+    landscapeActor->Destroy();
+  }
+
+  GEditor->RedrawLevelEditingViewports();
+}
+
+int FWorldCreatorBridgeModule::GetImportedLandscapeId(const AActor* actor) const
+{
+  // imported landscapes are labeled <terrainName>_<id>
+  const FString prefix = terrainName + TEXT("_");
+  const FString label = actor->GetActorLabel();
+  if (!label.StartsWith(prefix))
+    return INDEX_NONE;
+  const FString id = label.RightChop(prefix.Len());
+  return id.IsNumeric() ? FCString::Atoi(*id) : INDEX_NONE;
+}
+
+TMap<int, ALandscape*> FWorldCreatorBridgeModule::FindImportedLandscapes(UWorld* world) const
+{
+  TMap<int, ALandscape*> landscapes;
+  for (auto actorIter = FActorIterator(world); actorIter; ++actorIter)
+  {
+    if (actorIter->GetClass() == ALandscape::StaticClass())
+    {
+      const int landscapeId = GetImportedLandscapeId(*actorIter);
+      if (landscapeId != INDEX_NONE)
+        landscapes.Add(landscapeId, (ALandscape*)*actorIter);
+    }
+  }
+  return landscapes;
+}
+
+void FWorldCreatorBridgeModule::PlanTileHashes(FWCSyncContext& syncContext) const
+{
+  // World Creator tiles every landscape is assembled from
+  const TArray<FWCUnrealTile>& unrealTiles = syncContext.layoutTiles;
+  syncContext.landscapePlans.SetNum(unrealTiles.Num());
+  syncContext.landscapeTiles.SetNum(unrealTiles.Num());
+  for (int i = 0; i < unrealTiles.Num(); i++)
+  {
+    const FWCUnrealTile& unrealTile = unrealTiles[i];
+    BuildBlitPlan(unrealTile.startX, unrealTile.startY, unrealTile.heightDataWidth, unrealTile.heightDataLength, syncContext.landscapePlans[i]);
+    for (const FWCBlitPlanEntry& entry : syncContext.landscapePlans[i])
+    {
+      syncContext.landscapeTiles[i].AddUnique(entry.tileKey);
+      syncContext.tileKeys.AddUnique(entry.tileKey);
+    }
+  }
 }
 
-void FWorldCreatorBridgeModule::DeletePreviousImportedWorldCreatorLandscape(UWorld* world, FVector* location, FRotator* rotation)
+void FWorldCreatorBridgeModule::HashTiles(FWCSyncContext& syncContext, int firstTile, int numTiles) const
 {
-  // declaer landscape and gizmo pointer
-  ALandscape* landscapeActor = nullptr;
-  ALandscapeGizmoActiveActor* landscapeGizmo = nullptr;
-  ULevel* level = world->GetCurrentLevel();
-
-
-  //// Find existing landscape
-  ////////////////////////////
-  auto actorIter = FActorIterator(world);
-  bool actorfound = false;
-  while (actorIter)
-  {
-    if (actorfound) {
-      break;
-    }
-    if (actorIter->GetClass() == ALandscape::StaticClass() && actorIter->GetActorLabel().StartsWith(terrainName))
+  // the tile files are hashed in parallel, hashing is bound by reading them
+  numTiles = FMath::Min(numTiles, syncContext.tileKeys.Num() - firstTile);
+  if (numTiles <= 0)
+    return;
+  const TArray<FIntPoint>& tileKeys = syncContext.tileKeys;
+  const TArray<FWCManifestSplatmap>& splatmaps = syncContext.manifest->splatmaps;
+  TArray<uint64> tileHashes;
+  TArray<bool> tileHashed;
+  tileHashes.SetNumZeroed(numTiles);
+  tileHashed.Init(false, numTiles);
+  ParallelFor(numTiles, [this, firstTile, &tileKeys, &tileHashes, &tileHashed, &splatmaps](int32 tileIndex)
     {
-      landscapeActor = (ALandscape*)*actorIter;
-      actorfound = true;
-    }
-    ++actorIter;
+      tileHashed[tileIndex] = FWCSyncState::HashFiles(GetTileFilePaths(tileKeys[firstTile + tileIndex], splatmaps), tileHashes[tileIndex]);
+    });
+  // tiles whose files cannot be read get no hash, their landscapes count as changed now and in the next sync
+  for (int i = 0; i < numTiles; i++)
+  {
+    if (tileHashed[i])
+      syncContext.syncState.tileHashes.Add(tileKeys[firstTile + i], tileHashes[i]);
   }
-  //// Find existing gizmo
-  ////////////////////////
-  if (landscapeActor != nullptr)
+}
+
+TSet<int> FWorldCreatorBridgeModule::FindChangedLandscapes(FWCSyncContext& syncContext) const
+{
+  const TArray<FWCUnrealTile>& unrealTiles = syncContext.layoutTiles;
+  const TArray<TArray<FWCBlitPlanEntry>>& landscapePlans = syncContext.landscapePlans;
+  const TArray<TArray<FIntPoint>>& landscapeTiles = syncContext.landscapeTiles;
+  const FWCSyncState* previousSyncState = syncContext.bFullSync ? nullptr : &syncContext.previousSyncState;
+  FWCSyncState& syncState = syncContext.syncState;
+  TMap<int, FIntRect>& outDirtyRects = syncContext.dirtyRects;
+
+  const TMap<int, ALandscape*> existingLandscapes = FindImportedLandscapes(syncContext.world.Get());
+  TSet<int> changedLandscapes;
+  for (int i = 0; i < unrealTiles.Num(); i++)
   {
-    actorIter = FActorIterator(world);
-    while (actorIter)
+    const FWCUnrealTile& unrealTile = unrealTiles[i];
+    FXxHash64Builder builder;
+    builder.Update(&syncState.settingsHash, sizeof(syncState.settingsHash));
+    builder.Update(&unrealTile, sizeof(FWCUnrealTile));
+    bool bHashed = true;
+    for (const FIntPoint& tileKey : landscapeTiles[i])
     {
-      if (actorIter->GetClass() == ALandscapeGizmoActiveActor::StaticClass())
+      const uint64* tileHash = syncState.tileHashes.Find(tileKey);
+      if (tileHash == nullptr)
       {
-        auto gizmo = (ALandscapeGizmoActiveActor*)*actorIter;
-        if (gizmo->TargetLandscapeInfo == landscapeActor->GetLandscapeInfo())
-        {
-          landscapeGizmo = gizmo;
-          break;
-        }
+        bHashed = false;
+        break;
       }
-      ++actorIter;
+      builder.Update(&tileKey, sizeof(FIntPoint));
+      builder.Update(tileHash, sizeof(uint64));
     }
+    const uint64 landscapeHash = builder.Finalize().Hash;
+    if (bHashed)
+      syncState.landscapeHashes.Add(unrealTile.landscapeId, landscapeHash);
 
-    if (landscapeGizmo != nullptr)
+    // landscapes that were removed in the editor are imported again as well
+    const uint64* previousHash = previousSyncState != nullptr ? previousSyncState->landscapeHashes.Find(unrealTile.landscapeId) : nullptr;
+    if (!bHashed || previousHash == nullptr || *previousHash != landscapeHash || !existingLandscapes.Contains(unrealTile.landscapeId))
     {
-      landscapeGizmo->Destroy();
-      landscapeGizmo = nullptr;
-    }
+      changedLandscapes.Add(unrealTile.landscapeId);
 
-    // set the previous location to spawn the new terrain at 
-    *location = landscapeActor->GetActorLocation();
-    *rotation = landscapeActor->GetActorRotation();
-
-    if (level)
-    {
-      if (level->bIsPartitioned)
+      // the rects of the changed tiles in the data of the landscape, x runs along heightDataWidth
+      TOptional<FIntRect> dirtyRect;
+      for (const FWCBlitPlanEntry& entry : landscapePlans[i])
       {
-        UWorldPartitionEditorLoaderAdapter* EditorLoaderAdapter = world->GetWorldPartition()->CreateEditorLoaderAdapter<FLoaderAdapterShape>(world, REGIONBOX, TEXT("Loaded Region"));
-        EditorLoaderAdapter->GetLoaderAdapter()->SetUserCreated(true);
-        EditorLoaderAdapter->GetLoaderAdapter()->Load();
-
-        SelectedLoaderInterfaces.Empty();
-        SelectedLoaderInterfaces.Add(EditorLoaderAdapter);
-
-        auto actorIterforProxy = FActorIterator(world);
-        ALandscapeStreamingProxy* streamingProxy = nullptr;
-        auto streamProxyClass = ALandscapeStreamingProxy::StaticClass();
-
-        while (actorIterforProxy)
+        const uint64* tileHash = syncState.tileHashes.Find(entry.tileKey);
+        const uint64* previousTileHash = previousSyncState != nullptr ? previousSyncState->tileHashes.Find(entry.tileKey) : nullptr;
+        if (tileHash == nullptr || previousTileHash == nullptr || *previousTileHash != *tileHash)
         {
-          if (actorIterforProxy->GetClass() == streamProxyClass)
-          {
-            streamingProxy = (ALandscapeStreamingProxy*)*actorIterforProxy;
-            if (streamingProxy->GetLandscapeActor()->GetActorLabel().StartsWith(terrainName))
-            {
-              streamingProxy->Destroy();
-              streamingProxy = nullptr;
-            }
-          }
-          ++actorIterforProxy;
+          const FIntRect entryRect(entry.destX, entry.destY, entry.destX + entry.width, entry.destY + entry.length);
+          if (dirtyRect.IsSet())
+            dirtyRect->Union(entryRect);
+          else
+            dirtyRect = entryRect;
         }
-
-        EditorLoaderAdapter->GetLoaderAdapter()->Unload();
-        SelectedLoaderInterfaces.Empty();
       }
+      if (!dirtyRect.IsSet())
+      {
+        dirtyRect = FIntRect(0, 0, unrealTile.heightDataWidth, unrealTile.heightDataLength);
+      }
+      outDirtyRects.Add(unrealTile.landscapeId, dirtyRect.GetValue());
     }
-
-    landscapeActor->Destroy();
-
-    //actorIter = FActorIterator(world);
-    //while (actorIter)
-    //{
-    //  if (actorIter->GetClass() == ALandscape::StaticClass() && actorIter->GetActorLabel().StartsWith(terrainName))
-    //  {
-    //    landscapeActor = Cast<ALandscape>(*actorIter);
-    //    landscapeActor->Destroy();
-    //  }
-    //  ++actorIter;
-    //}
-
-    GEditor->RedrawLevelEditingViewports();
   }
+  return changedLandscapes;
+}
+
+uint64 FWorldCreatorBridgeModule::GetSyncSettingsHash() const
+{
+  // everything besides the tile files that changes the imported landscapes, their materials or layer infos
+  FXxHash64Builder builder;
+  const uint64 manifestHash = manifest->GetHash();
+  builder.Update(&manifestHash, sizeof(manifestHash));
+  builder.Update(*terrainName, terrainName.Len() * sizeof(TCHAR));
+  builder.Update(*terrainMaterialName, terrainMaterialName.Len() * sizeof(TCHAR));
+  const int settings[] = { version, unrealTerrainResolution, quatsPerSection, bImportLayers, bImportTextures, bUseWorldPartition, worldPartitionGridSize, worldPartitionRegionSize };
+  builder.Update(settings, sizeof(settings));
+  builder.Update(&worldScale, sizeof(worldScale));
+  return builder.Finalize().Hash;
 }
 
 //ALandscapeProxy* FindOrAddLandscapeStreamingProxy(UActorPartitionSubsystem* InActorPartitionSubsystem, ULandscapeInfo* InLandscapeInfo, const UActorPartitionSubsystem::FCellCoord& InCellCoord)
@@ -2531,21 +3569,16 @@ void FWorldCreatorBridgeModule::ImportHeightMapToLandscape(UWorld* world, TShare
   const UPROPERTY() FGuid landscapeGuid = FGuid::FGuid();
   UPROPERTY() TMap<FGuid, TArray<uint16>> heightDataMap;
   UPROPERTY() TMap<FGuid, TArray<FLandscapeImportLayerInfo>> layerInfosMap;
-  heightDataMap.Add(landscapeGuid, data->heightData);
-  layerInfosMap.Add(landscapeGuid, data->layerInfos);
+  // Import only reads the maps, the buffers are moved in instead of copying them once more
+  heightDataMap.Add(landscapeGuid, MoveTemp(data->heightData));
+  TArray<FLandscapeImportLayerInfo>& importLayerInfos = layerInfosMap.Add(landscapeGuid, MoveTemp(data->layerInfos));
 
   landscapeActor = world->SpawnActor<ALandscape>(location, rotation);
   if (data->material != nullptr)
-    landscapeActor->LandscapeMaterial = (UMaterialInterface*)data->material;
+    landscapeActor->LandscapeMaterial = data->material;
   landscapeActor->StaticLightingLOD = FMath::DivideAndRoundUp(FMath::CeilLogTwo((_width * _length) / (2048 * 2048) + 1), (uint32)2);
   // landscapeActor->SetLandscapeGuid(FGuid::NewGuid());
 
-  int componentCountX = floor(_width / quatsPerSection * _inNumSections);
-  int componentCountY = floor(_length / quatsPerSection * _inNumSections);
-  const bool bIsWorldPartition = world->GetSubsystem<ULandscapeSubsystem>()->IsGridBased();
-  const bool bLandscapeLargerThanRegion = worldPartitionRegionSize < componentCountX || worldPartitionRegionSize < componentCountY;
-  const bool bNeedsLandscapeRegions = bIsWorldPartition && bLandscapeLargerThanRegion;
-
   UE_LOG(LogTemp, Log, TEXT("%d"), _inNumSections);
 
   int a = 0;
@@ -2553,10 +3586,38 @@ void FWorldCreatorBridgeModule::ImportHeightMapToLandscape(UWorld* world, TShare
   //TArray<uint16>heightmap = ReadRawHeightmap(L"", a, b);
   TArray<FLandscapeLayer> landscapeLayers;
   landscapeLayers.Init(FLandscapeLayer(), 1);
+  // the import copies the heights and weights into the textures of the components
+  int64 importedBytes = heightDataMap[landscapeGuid].Num() * sizeof(uint16);
+  for (const FLandscapeImportLayerInfo& layerInfo : importLayerInfos)
+  {
+    importedBytes += layerInfo.LayerData.Num();
+  }
+  syncStats.AddCopied(importedBytes);
   landscapeActor->Import(FGuid::NewGuid(), 0, 0, _width - 1, _length - 1, _inNumSections, data->quatsPerSection,
     heightDataMap, L"", layerInfosMap, ELandscapeImportAlphamapType::Additive);
   
-  
+  heightDataMap.Empty();
+  for (FLandscapeImportLayerInfo& layerInfo : importLayerInfos)
+  {
+    layerInfo.LayerData.Empty();
+  }
+
+  FinishLandscapeImport(world, landscapeActor, data, _width, _length, id, location, rotation);
+  for (int li = 0; li < importLayerInfos.Num(); li++)
+  {
+    landscapeActor->EditorLayerSettings.Add(FLandscapeEditorLayerSettings(importLayerInfos[li].LayerInfo));
+  }
+}
+
+void FWorldCreatorBridgeModule::FinishLandscapeImport(UWorld* world, ALandscape* landscapeActor, TSharedPtr<LandscapeImportData> data, int _width, int _length, int id, FVector location, FRotator rotation)
+{
+  int _inNumSections = 1;
+  int componentCountX = floor(_width / quatsPerSection * _inNumSections);
+  int componentCountY = floor(_length / quatsPerSection * _inNumSections);
+  const bool bIsWorldPartition = world->GetSubsystem<ULandscapeSubsystem>()->IsGridBased();
+  const bool bLandscapeLargerThanRegion = worldPartitionRegionSize < componentCountX || worldPartitionRegionSize < componentCountY;
+  const bool bNeedsLandscapeRegions = bIsWorldPartition && bLandscapeLargerThanRegion;
+
   UPROPERTY() ULandscapeInfo* info = landscapeActor->GetLandscapeInfo();
   info->UpdateLayerInfoMap(landscapeActor);
   landscapeActor->SetActorScale3D(FVector(data->scaleX, data->scaleY, data->terrainScale));
@@ -2606,107 +3667,243 @@ void FWorldCreatorBridgeModule::ImportHeightMapToLandscape(UWorld* world, TShare
 
     }
   }
+}
+
+void FWorldCreatorBridgeModule::ImportStreamedLandscape(UWorld* world, TSharedPtr<LandscapeImportData> data, const FWCUnrealTile& unrealTile, const TArray<FWCManifestSplatmap>& splatmaps, int numSplatChannels, FVector location, FRotator rotation)
+{
+  // the landscape x axis runs along the length of the unreal tile
+  const int _width = unrealTile.heightDataLength;
+  const int _length = unrealTile.heightDataWidth;
+  ALandscape* landscapeActor = CreateStreamedLandscape(world, data, _width, _length, location, rotation);
+
+  // a region is a band of component rows, the next one is assembled on a worker while the current one is written
+  const int regionRows = STREAM_REGION_COMPONENTS * data->quatsPerSection;
+  auto launchRegionTask = [this, &unrealTile, &splatmaps, numSplatChannels, regionRows](int regionStart)
+    {
+      // neighbouring regions share their border row
+      const int regionWidth = FMath::Min(regionRows + 1, unrealTile.heightDataWidth - regionStart);
+      return UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, unrealTile, &splatmaps, numSplatChannels, regionStart, regionWidth]()
+        {
+          return AssembleUnrealTile(unrealTile, splatmaps, numSplatChannels, regionStart, regionWidth);
+        });
+    };
+
+  {
+    // with edit layers the data is written into the default layer, the final textures are merged from it
+    TOptional<FScopedSetLandscapeEditingLayer> editingLayer;
+    if (landscapeActor->HasLayersContent() && landscapeActor->GetLayer(0) != nullptr)
+    {
+      editingLayer.Emplace(landscapeActor, landscapeActor->GetLayer(0)->Guid);
+    }
+
+    UE::Tasks::TTask<TSharedPtr<FWCAssembledTile>> regionTask = launchRegionTask(0);
+    for (int regionStart = 0; regionStart < _length - 1; regionStart += regionRows)
+    {
+      TSharedPtr<FWCAssembledTile> region = regionTask.GetResult();
+      if (regionStart + regionRows < _length - 1)
+      {
+        regionTask = launchRegionTask(regionStart + regionRows);
+      }
+      WriteLandscapeRegion(landscapeActor, *region, data->layerInfos);
+    }
+  }
+
+  if (landscapeActor->HasLayersContent())
+  {
+    landscapeActor->RequestLayersContentUpdateForceAll();
+  }
+  FinishLandscapeImport(world, landscapeActor, data, _width, _length, unrealTile.landscapeId, location, rotation);
+}
+
+bool FWorldCreatorBridgeModule::CanUpdateLandscapeInPlace(ALandscape* landscapeActor, const FWCUnrealTile& unrealTile, int numSplatChannels)
+{
+  // the landscape x axis runs along the length of the unreal tile. Landscapes with a different size or with
+  // components that are not loaded (world partition) are imported again instead
+  ULandscapeInfo* info = landscapeActor->GetLandscapeInfo();
+  int32 minX, minY, maxX, maxY;
+  if (info == nullptr || !info->GetLandscapeExtent(minX, minY, maxX, maxY))
+    return false;
+  if (minX != 0 || minY != 0 || maxX != unrealTile.heightDataLength - 1 || maxY != unrealTile.heightDataWidth - 1)
+    return false;
+  const int numComponents = ((unrealTile.heightDataLength - 1) / quatsPerSection) * ((unrealTile.heightDataWidth - 1) / quatsPerSection);
+  if (info->XYtoComponentMap.Num() != numComponents)
+    return false;
+
+  TArray<FLandscapeImportLayerInfo> layerInfos;
+  return LoadLayerInfos(unrealTile, bImportLayers ? numSplatChannels : 1, layerInfos);
+}
+
+bool FWorldCreatorBridgeModule::UpdateLandscapeInPlace(ALandscape* landscapeActor, const FWCUnrealTile& unrealTile, const FIntRect& dirtyRect, const FWCAssembledTile& region, int numSplatChannels)
+{
+  TArray<FLandscapeImportLayerInfo> layerInfos;
+  if (!CanUpdateLandscapeInPlace(landscapeActor, unrealTile, numSplatChannels) || !LoadLayerInfos(unrealTile, bImportLayers ? numSplatChannels : 1, layerInfos))
+    return false;
+
+  {
+    TOptional<FScopedSetLandscapeEditingLayer> editingLayer;
+    if (landscapeActor->HasLayersContent() && landscapeActor->GetLayer(0) != nullptr)
+    {
+      editingLayer.Emplace(landscapeActor, landscapeActor->GetLayer(0)->Guid);
+    }
+
+    // the edit interface only touches the components in the rect, their collision and render state are updated by it
+    WriteLandscapeRegion(landscapeActor, region, layerInfos, dirtyRect.Min.Y, dirtyRect.Max.Y - 1);
+  }
+  landscapeActor->MarkPackageDirty();
+  return true;
+}
+
+ALandscape* FWorldCreatorBridgeModule::CreateStreamedLandscape(UWorld* world, TSharedPtr<LandscapeImportData> data, int _width, int _length, FVector location, FRotator rotation)
+{
+  ALandscape* landscapeActor = world->SpawnActor<ALandscape>(location, rotation);
+  if (data->material != nullptr)
+    landscapeActor->LandscapeMaterial = data->material;
+  landscapeActor->StaticLightingLOD = FMath::DivideAndRoundUp(FMath::CeilLogTwo((_width * _length) / (2048 * 2048) + 1), (uint32)2);
+  landscapeActor->SetLandscapeGuid(FGuid::NewGuid());
+  landscapeActor->ComponentSizeQuads = data->quatsPerSection;
+  landscapeActor->SubsectionSizeQuads = data->quatsPerSection;
+  landscapeActor->NumSubsections = 1;
   for (int li = 0; li < data->layerInfos.Num(); li++)
   {
     landscapeActor->EditorLayerSettings.Add(FLandscapeEditorLayerSettings(data->layerInfos[li].LayerInfo));
   }
+
+  ULandscapeInfo* info = landscapeActor->CreateLandscapeInfo();
+  if (landscapeActor->CanHaveLayersContent())
+  {
+    landscapeActor->CreateDefaultLayer();
+  }
+
+  // the components start flat, their heights and weights are written region by region
+  TArray<FIntPoint> componentCoordinates;
+  const int componentCountX = (_width - 1) / data->quatsPerSection;
+  const int componentCountY = (_length - 1) / data->quatsPerSection;
+  componentCoordinates.Reserve(componentCountX * componentCountY);
+  for (int y = 0; y < componentCountY; y++)
+  {
+    for (int x = 0; x < componentCountX; x++)
+    {
+      componentCoordinates.Add(FIntPoint(x, y));
+    }
+  }
+  AddComponents(info, landscapeActor, componentCoordinates);
+  info->UpdateLayerInfoMap(landscapeActor);
+  return landscapeActor;
 }
 
+void FWorldCreatorBridgeModule::WriteLandscapeRegion(ALandscape* landscapeActor, const FWCAssembledTile& region, const TArray<FLandscapeImportLayerInfo>& layerInfos, int x1, int x2)
+{
+  // the assembled rows run along the landscape x axis, so a region covers landscape rows, by default whole ones
+  const int stride = region.unrealTile.heightDataLength;
+  if (x2 < 0)
+    x2 = stride - 1;
+  const int y1 = region.regionStart;
+  const int y2 = region.regionStart + region.regionWidth - 1;
+
+  // the edit interface stages the rect in its own buffers before writing the component textures
+  const int64 rectPixels = (int64)(x2 - x1 + 1) * (y2 - y1 + 1);
+  syncStats.AddCopied(rectPixels * (sizeof(uint16) + FMath::Min(layerInfos.Num(), region.splatData.Num())));
+
+  FLandscapeEditDataInterface landscapeEdit(landscapeActor->GetLandscapeInfo());
+  landscapeEdit.SetHeightData(x1, y1, x2, y2, region.heightData.GetData() + x1, stride, true);
+  for (int i = 0; i < layerInfos.Num() && i < region.splatData.Num(); i++)
+  {
+    // the weights are written as they are, like the additive import of the full landscapes
+    landscapeEdit.SetAlphaData(layerInfos[i].LayerInfo, x1, y1, x2, y2, region.splatData[i].GetData() + x1, stride, ELandscapeLayerPaintingRestriction::None, false, false);
+  }
+  landscapeEdit.Flush();
+}
 
 
-//void FWorldCreatorBridgeModule::AddComponents(ULandscapeInfo* InLandscapeInfo, ULandscapeSubsystem* InLandscapeSubsystem, const TArray<FIntPoint>& InComponentCoordinates, TArray<ALandscapeProxy*>& OutCreatedStreamingProxies)
-//{
-//  TRACE_CPUPROFILER_EVENT_SCOPE(AddComponents);
-//  TArray<ULandscapeComponent*> NewComponents;
-//  InLandscapeInfo->Modify();
-//  for (const FIntPoint& ComponentCoordinate : InComponentCoordinates)
-//  {
-//    ULandscapeComponent* LandscapeComponent = InLandscapeInfo->XYtoComponentMap.FindRef(ComponentCoordinate);
-//    if (LandscapeComponent)
-//    {
-//      continue;
-//    }
-//
-//    // Add New component...
-//    FIntPoint ComponentBase = ComponentCoordinate * InLandscapeInfo->ComponentSizeQuads;
-//
-//    ALandscapeProxy* LandscapeProxy = InLandscapeSubsystem->FindOrAddLandscapeProxy(InLandscapeInfo, ComponentBase);
-//    if (!LandscapeProxy)
-//    {
-//      continue;
-//    }
-//
-//    OutCreatedStreamingProxies.Add(LandscapeProxy);
-//
-//    LandscapeComponent = NewObject<ULandscapeComponent>(LandscapeProxy, NAME_None, RF_Transactional);
-//    NewComponents.Add(LandscapeComponent);
-//    LandscapeComponent->Init(
-//      ComponentBase.X, ComponentBase.Y,
-//      LandscapeProxy->ComponentSizeQuads,
-//      LandscapeProxy->NumSubsections,
-//      LandscapeProxy->SubsectionSizeQuads
-//    );
-//
-//    TArray<FColor> HeightData;
-//    const int32 ComponentVerts = (LandscapeComponent->SubsectionSizeQuads + 1) * LandscapeComponent->NumSubsections;
-//    const FColor PackedMidpoint = LandscapeDataAccess::PackHeight(LandscapeDataAccess::GetTexHeight(0.0f));
-//    HeightData.Init(PackedMidpoint, FMath::Square(ComponentVerts));
-//
-//    LandscapeComponent->InitHeightmapData(HeightData, true);
-//    LandscapeComponent->UpdateMaterialInstances();
-//
-//    InLandscapeInfo->XYtoComponentMap.Add(ComponentCoordinate, LandscapeComponent);
-//    InLandscapeInfo->XYtoAddCollisionMap.Remove(ComponentCoordinate);
-//  }
-//
-//  // Need to register to use general height/xyoffset data update
-//  for (int32 Idx = 0; Idx < NewComponents.Num(); Idx++)
-//  {
-//    NewComponents[Idx]->RegisterComponent();
-//  }
-//
-//  const bool bHasXYOffset = false;
-//  ALandscape* Landscape = InLandscapeInfo->LandscapeActor.Get();
-//
-//  bool bHasLandscapeLayersContent = Landscape && Landscape->HasLayersContent();
-//
-//  for (ULandscapeComponent* NewComponent : NewComponents)
-//  {
-//    if (bHasLandscapeLayersContent)
-//    {
-//      TArray<ULandscapeComponent*> ComponentsUsingHeightmap;
-//      ComponentsUsingHeightmap.Add(NewComponent);
-//
-//      for (const FLandscapeLayer& Layer : Landscape->LandscapeLayers)
-//      {
-//        // Since we do not share heightmap when adding new component, we will provided the required array, but they will only be used for 1 component
-//        TMap<UTexture2D*, UTexture2D*> CreatedHeightmapTextures;
-//        NewComponent->AddDefaultLayerData(Layer.Guid, ComponentsUsingHeightmap, CreatedHeightmapTextures);
-//      }
-//    }
-//
-//    // Update Collision
-//    NewComponent->UpdateCachedBounds();
-//    NewComponent->UpdateBounds();
-//    NewComponent->MarkRenderStateDirty();
-//
-//    if (!bHasLandscapeLayersContent)
-//    {
-//      ULandscapeHeightfieldCollisionComponent* CollisionComp = NewComponent->GetCollisionComponent();
-//      if (CollisionComp && !bHasXYOffset)
-//      {
-//        CollisionComp->MarkRenderStateDirty();
-//        CollisionComp->RecreateCollision();
-//      }
-//    }
-//  }
-//
-//
-//  if (Landscape)
-//  {
-//    GEngine->BroadcastOnActorMoved(Landscape);
-//  }
-//}
+
+void FWorldCreatorBridgeModule::AddComponents(ULandscapeInfo* InLandscapeInfo, ALandscapeProxy* InLandscapeProxy, const TArray<FIntPoint>& InComponentCoordinates)
+{
+  TRACE_CPUPROFILER_EVENT_SCOPE(AddComponents);
+  TArray<ULandscapeComponent*> NewComponents;
+  InLandscapeInfo->Modify();
+  for (const FIntPoint& ComponentCoordinate : InComponentCoordinates)
+  {
+    ULandscapeComponent* LandscapeComponent = InLandscapeInfo->XYtoComponentMap.FindRef(ComponentCoordinate);
+    if (LandscapeComponent)
+    {
+      continue;
+    }
+
+    // Add New component...
+    FIntPoint ComponentBase = ComponentCoordinate * InLandscapeInfo->ComponentSizeQuads;
+
+    // the components are added to the landscape itself, world partition moves them into streaming proxies afterwards
+    LandscapeComponent = NewObject<ULandscapeComponent>(InLandscapeProxy, NAME_None, RF_Transactional);
+    NewComponents.Add(LandscapeComponent);
+    LandscapeComponent->Init(
+      ComponentBase.X, ComponentBase.Y,
+      InLandscapeProxy->ComponentSizeQuads,
+      InLandscapeProxy->NumSubsections,
+      InLandscapeProxy->SubsectionSizeQuads
+    );
+    InLandscapeProxy->LandscapeComponents.AddUnique(LandscapeComponent);
+    LandscapeComponent->AttachToComponent(InLandscapeProxy->GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+
+    TArray<FColor> HeightData;
+    const int32 ComponentVerts = (LandscapeComponent->SubsectionSizeQuads + 1) * LandscapeComponent->NumSubsections;
+    const FColor PackedMidpoint = LandscapeDataAccess::PackHeight(LandscapeDataAccess::GetTexHeight(0.0f));
+    HeightData.Init(PackedMidpoint, FMath::Square(ComponentVerts));
+
+    LandscapeComponent->InitHeightmapData(HeightData, true);
+    LandscapeComponent->UpdateMaterialInstances();
+
+    InLandscapeInfo->XYtoComponentMap.Add(ComponentCoordinate, LandscapeComponent);
+    InLandscapeInfo->XYtoAddCollisionMap.Remove(ComponentCoordinate);
+  }
+
+  // Need to register to use general height/xyoffset data update
+  for (int32 Idx = 0; Idx < NewComponents.Num(); Idx++)
+  {
+    NewComponents[Idx]->RegisterComponent();
+  }
+
+  const bool bHasXYOffset = false;
+  ALandscape* Landscape = InLandscapeInfo->LandscapeActor.Get();
+
+  bool bHasLandscapeLayersContent = Landscape && Landscape->HasLayersContent();
+
+  for (ULandscapeComponent* NewComponent : NewComponents)
+  {
+    if (bHasLandscapeLayersContent)
+    {
+      TArray<ULandscapeComponent*> ComponentsUsingHeightmap;
+      ComponentsUsingHeightmap.Add(NewComponent);
+
+      for (const FLandscapeLayer& Layer : Landscape->LandscapeLayers)
+      {
+        // Since we do not share heightmap when adding new component, we will provided the required array, but they will only be used for 1 component
+        TMap<UTexture2D*, UTexture2D*> CreatedHeightmapTextures;
+        NewComponent->AddDefaultLayerData(Layer.Guid, ComponentsUsingHeightmap, CreatedHeightmapTextures);
+      }
+    }
+
+    // Update Collision
+    NewComponent->UpdateCachedBounds();
+    NewComponent->UpdateBounds();
+    NewComponent->MarkRenderStateDirty();
+
+    if (!bHasLandscapeLayersContent)
+    {
+      ULandscapeHeightfieldCollisionComponent* CollisionComp = NewComponent->GetCollisionComponent();
+      if (CollisionComp && !bHasXYOffset)
+      {
+        CollisionComp->MarkRenderStateDirty();
+        CollisionComp->RecreateCollision();
+      }
+    }
+  }
+
+
+  if (Landscape)
+  {
+    GEngine->BroadcastOnActorMoved(Landscape);
+  }
+}
 
 int FWorldCreatorBridgeModule::RecaulculateToUnrealSize(int quadsPerSection, int size)
 {
@@ -2717,35 +3914,38 @@ int FWorldCreatorBridgeModule::RecaulculateToUnrealSize(int quadsPerSection, int
 bool FWorldCreatorBridgeModule::SetupXmlVariables()
 {
   syncDir = FPaths::GetPath(selectedPath);
-  FXmlFile configFile(selectedPath);
-  root = configFile.GetRootNode();
-  if (root == NULL)
-    return false;
-  FXmlNode* node = root->FindChildNode(TEXT("Surface"));
-  if (node == nullptr)
+  // the only parse of the manifest per sync, all later stages read it from here
   {
-    configFile.Clear();
-    return false;
+    TRACE_CPUPROFILER_EVENT_SCOPE(FWorldCreatorBridgeModule::ParseManifest);
+    FWCSyncStats::FScopedStage stage(syncStats, EWCSyncStage::Parse, FMath::Max<int64>(0, IFileManager::Get().FileSize(*selectedPath)));
+    manifest = FWCSyncManifest::Load(selectedPath);
   }
+  if (!manifest.IsValid())
+    return false;
   // assign values 
   // commented out values are currently not in use 
 
-  minHeight = XmlHelper::GetFloat(node, "MinHeight");
-  maxHeight = XmlHelper::GetFloat(node, "MaxHeight");
-  width = XmlHelper::GetInt(node, "Width");
-  length = XmlHelper::GetInt(node, "Length");
-  resX = XmlHelper::GetInt(node, "ResolutionX");
-  resY = XmlHelper::GetInt(node, "ResolutionY");
+  minHeight = manifest->minHeight;
+  maxHeight = manifest->maxHeight;
+  width = manifest->width;
+  length = manifest->length;
+  resX = manifest->resolutionX;
+  resY = manifest->resolutionY;
   rescaleFactor = 1; // (resX / width + resY / length) / 2;
   scaleX = (float)width / resX;
   scaleY = (float)length / resY;
   width = (resX);
   length = (resY);
-  numTilesX = XmlHelper::GetInt(node, "TilesX");
-  numTilesY = XmlHelper::GetInt(node, "TilesY");
-  tileResolution = XmlHelper::GetInt(node, "TileResolution");
+  numTilesX = manifest->tilesX;
+  numTilesY = manifest->tilesY;
+  tileResolution = manifest->tileResolution;
+  if (tileResolution <= 0)
+  {
+    // manifests of older versions do not contain the tile resolution
+    tileResolution = WC_TILE_RESOLUTION;
+  }
 
-  float tmpVersion = XmlHelper::GetFloat(root, "Version");
+  float tmpVersion = manifest->version;
   if (VERSIONMAP.Contains(tmpVersion))
   {
     version = VERSIONMAP[tmpVersion];
@@ -2756,7 +3956,7 @@ bool FWorldCreatorBridgeModule::SetupXmlVariables()
   }
 
 
-  if (version == 1 && XmlHelper::GetInt(root->FindChildNode(TEXT("Surface")), "HeightCenter") < 0)
+  if (version == 1 && manifest->heightCenter < 0)
   {
     version = 3;
   }
@@ -2764,17 +3964,19 @@ bool FWorldCreatorBridgeModule::SetupXmlVariables()
   if (version == 2)
   {
 
-    FXmlNode* tmpNode = root->FindChildNode(TEXT("Texturing"))->GetChildrenNodes()[0];
-    FString fileName = XmlHelper::GetString(tmpNode, "Name");
+    if (manifest->splatmaps.Num() == 0)
+      return false;
+    const FString& fileName = manifest->splatmaps[0].name;
     FString filePath = FString::Printf(TEXT("%s/%s"), syncDir.GetCharArray().GetData(), fileName.GetCharArray().GetData());
 
-    TArray<uint8> fileData;
-
-    FFileHelper::LoadFileToArray(fileData, filePath.GetCharArray().GetData());
-
-    uint8* dataPtr = (fileData).GetData();
-    int tmpWidth = *(short*)(&dataPtr[12]);
-    int tmpLength = *(short*)(&dataPtr[14]);
+    FWCTgaHeader header;
+    if (!FWCTgaReader::Probe(filePath, header))
+    {
+      UE_LOG(LogTemp, Error, TEXT("Failed to read splatmap header %s"), *filePath);
+      return false;
+    }
+    int tmpWidth = header.width;
+    int tmpLength = header.height;
     rescaleFactor = (tmpWidth / width + tmpLength / length) / 2;
     width = tmpWidth;
     length = tmpLength;
@@ -2786,7 +3988,6 @@ bool FWorldCreatorBridgeModule::SetupXmlVariables()
 
   unrealNumTilesX = 1 + (resX / (unrealTerrainResolution + UNREAL_MIN_TILE_RESOLUTION));
   unrealNumTilesY = 1 + (resY / (unrealTerrainResolution + UNREAL_MIN_TILE_RESOLUTION));
-  configFile.Clear();
   return true;
 }
 
@@ -2820,6 +4021,10 @@ TOptional<int> FWorldCreatorBridgeModule::GetQuatPSSizeDelta() const
 {
   return quatsPerSection;
 }
+TOptional<int> FWorldCreatorBridgeModule::GetTileCacheBudgetDelta() const
+{
+  return tileCacheBudgetMB;
+}
 
 TOptional<FString> FWorldCreatorBridgeModule::GetSelectedPath() const
 {
@@ -0,0 +1,123 @@
+// Copyright BiteTheBytes GmbH
+
+#include "WorldCreatorSyncCommandlet.h"
+#include "WorldCreatorBridge.h"
+#include "WCSyncSettings.h"
+#include "WCCommandletHelper.h"
+#include "FileHelpers.h"
+#include "LandscapeConfigHelper.h"
+#include "Misc/Paths.h"
+
+UWorldCreatorSyncCommandlet::UWorldCreatorSyncCommandlet()
+{
+  IsClient = false;
+  IsServer = false;
+  IsEditor = true;
+  LogToConsole = true;
+  ShowErrorCount = true;
+
+  HelpDescription = TEXT("Imports a World Creator sync (Bridge.xml) into a map and saves it");
+  HelpUsage = TEXT("UnrealEditor-Cmd <Project> -run=WorldCreatorSync -Map=<Map> [-Xml=<Bridge.xml>] [options] -nullrhi");
+  HelpParamNames = {
+    TEXT("Map"), TEXT("Xml"), TEXT("TerrainName"), TEXT("MaterialName"), TEXT("QuadsPerSection"), TEXT("Resolution"),
+    TEXT("WorldScale"), TEXT("WorldPartition"), TEXT("GridSize"), TEXT("RegionSize"), TEXT("TileCacheMB"),
+    TEXT("NoTextures"), TEXT("NoLayers"), TEXT("Stream"), TEXT("FullSync"), TEXT("NoUpdateInPlace"), TEXT("PackTextures"), TEXT("LayerArrays"),
+    TEXT("Minimap"), TEXT("NoSave") };
+  HelpParamDescriptions = {
+    TEXT("Map to import into, e.g. /Game/Maps/Terrain"),
+    TEXT("Bridge.xml of the sync, defaults to the World Creator sync folder"),
+    TEXT("Name of the imported terrain"),
+    TEXT("Name of the terrain material"),
+    TEXT("Quads per landscape section, one of the values of the landscape editor"),
+    TEXT("Maximum resolution of one landscape"),
+    TEXT("Scale of the terrain"),
+    TEXT("Import into world partition"),
+    TEXT("World partition grid size"),
+    TEXT("World partition region size"),
+    TEXT("Memory budget of the decoded World Creator tiles"),
+    TEXT("Skip the import of the color and texture maps"),
+    TEXT("Skip the import of the splatmap layers"),
+    TEXT("Write the landscapes region by region"),
+    TEXT("Import all landscapes instead of the changed ones"),
+    TEXT("Re-import changed landscapes instead of updating them"),
+    TEXT("Pack ambient occlusion, roughness and displacement of every layer into one texture"),
+    TEXT("Put the layer textures of each map type into one texture array"),
+    TEXT("Build the minimap after the import"),
+    TEXT("Do not save the map and the imported assets") };
+}
+
+int32 UWorldCreatorSyncCommandlet::Main(const FString& Params)
+{
+  TArray<FString> tokens;
+  TArray<FString> switches;
+  TMap<FString, FString> params;
+  ParseCommandLine(*Params, tokens, switches, params);
+
+  FString mapName;
+  WCCommandletHelper::GetString(params, TEXT("Map"), mapName);
+  if (mapName.Len() <= 0)
+  {
+    UE_LOG(LogTemp, Error, TEXT("No map given. Usage: %s"), *HelpUsage);
+    return 1;
+  }
+
+  FWCSyncSettings settings;
+  WCCommandletHelper::GetString(params, TEXT("Xml"), settings.bridgeFilePath);
+  WCCommandletHelper::GetString(params, TEXT("TerrainName"), settings.terrainName);
+  WCCommandletHelper::GetString(params, TEXT("MaterialName"), settings.terrainMaterialName);
+  WCCommandletHelper::GetInt(params, TEXT("QuadsPerSection"), settings.quadsPerSection);
+  WCCommandletHelper::GetInt(params, TEXT("Resolution"), settings.landscapeResolution);
+  WCCommandletHelper::GetFloat(params, TEXT("WorldScale"), settings.worldScale);
+  WCCommandletHelper::GetInt(params, TEXT("GridSize"), settings.worldPartitionGridSize);
+  WCCommandletHelper::GetInt(params, TEXT("RegionSize"), settings.worldPartitionRegionSize);
+  WCCommandletHelper::GetInt(params, TEXT("TileCacheMB"), settings.tileCacheBudgetMB);
+  settings.bUseWorldPartition = switches.Contains(TEXT("WorldPartition"));
+  settings.bImportTextures = !switches.Contains(TEXT("NoTextures"));
+  settings.bImportLayers = !switches.Contains(TEXT("NoLayers"));
+  settings.bStreamImport = switches.Contains(TEXT("Stream"));
+  settings.bIncrementalSync = !switches.Contains(TEXT("FullSync"));
+  settings.bUpdateInPlace = !switches.Contains(TEXT("NoUpdateInPlace"));
+  settings.bPackLayerTextures = switches.Contains(TEXT("PackTextures"));
+  settings.bLayerTextureArrays = switches.Contains(TEXT("LayerArrays"));
+  settings.bBuildMinimap = switches.Contains(TEXT("Minimap"));
+
+  bool bValidQuads = false;
+  for (int32 i = 0; i < UE_ARRAY_COUNT(FLandscapeConfig::SubsectionSizeQuadsValues); i++)
+  {
+    bValidQuads |= FLandscapeConfig::SubsectionSizeQuadsValues[i] == settings.quadsPerSection;
+  }
+  if (!bValidQuads)
+  {
+    UE_LOG(LogTemp, Error, TEXT("%d is not a valid number of quads per section"), settings.quadsPerSection);
+    return 1;
+  }
+  const FString bridgeFilePath = settings.bridgeFilePath.Len() > 0 ? settings.bridgeFilePath : FWCSyncSettings::GetDefaultBridgeFilePath();
+  if (!FPaths::FileExists(bridgeFilePath))
+  {
+    UE_LOG(LogTemp, Error, TEXT("Bridge file %s does not exist"), *bridgeFilePath);
+    return 1;
+  }
+
+  UWorld* world = UEditorLoadingAndSavingUtils::LoadMap(mapName);
+  if (world == nullptr)
+  {
+    UE_LOG(LogTemp, Error, TEXT("Failed to load map %s"), *mapName);
+    return 1;
+  }
+
+  FWorldCreatorBridgeModule& bridge = FModuleManager::LoadModuleChecked<FWorldCreatorBridgeModule>("WorldCreatorBridge");
+  const double startTime = FPlatformTime::Seconds();
+  if (!bridge.RunSync(world, settings))
+  {
+    UE_LOG(LogTemp, Error, TEXT("Sync of %s into %s failed"), *bridgeFilePath, *mapName);
+    return 1;
+  }
+  UE_LOG(LogTemp, Display, TEXT("Synced %s into %s in %.2f s"), *settings.terrainName, *mapName, FPlatformTime::Seconds() - startTime);
+
+  if (!switches.Contains(TEXT("NoSave")) && !UEditorLoadingAndSavingUtils::SaveDirtyPackages(true, true))
+  {
+    UE_LOG(LogTemp, Error, TEXT("Failed to save the synced packages of %s"), *mapName);
+    return 1;
+  }
+  return 0;
+}
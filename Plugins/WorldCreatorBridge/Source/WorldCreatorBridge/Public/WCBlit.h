@@ -0,0 +1,25 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EWCBlitOrientation : uint8
+{
+  None = 0,
+  FlipX = 1 << 0,
+  FlipY = 1 << 1,
+  // source rows become destination columns, e.g. World Creator rows into the column major landscape data
+  Transpose = 1 << 2,
+};
+ENUM_CLASS_FLAGS(EWCBlitOrientation);
+
+// Copies a width x height rect between two planes. Strides are in elements, flips are applied in source space before
+// the transpose. Transposing blits walk the rect in BLOCK_SIZE blocks so the strided stores stay in cache.
+class FWCBlit
+{
+public:
+  static const int BLOCK_SIZE = 64;
+
+  static void Blit16(const uint16* src, int64 srcStride, uint16* dst, int64 dstStride, int32 width, int32 height, EWCBlitOrientation orientation);
+  static void Blit8(const uint8* src, int64 srcStride, uint8* dst, int64 dstStride, int32 width, int32 height, EWCBlitOrientation orientation);
+};
@@ -0,0 +1,28 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Reads the -Name=Value parameters UCommandlet::ParseCommandLine returns, values that are not given keep the
+// default in outValue.
+class WCCommandletHelper
+{
+public:
+  static void GetInt(const TMap<FString, FString>& params, const TCHAR* name, int& outValue)
+  {
+    if (const FString* value = params.Find(name))
+      outValue = FCString::Atoi(**value);
+  }
+
+  static void GetFloat(const TMap<FString, FString>& params, const TCHAR* name, float& outValue)
+  {
+    if (const FString* value = params.Find(name))
+      outValue = FCString::Atof(**value);
+  }
+
+  static void GetString(const TMap<FString, FString>& params, const TCHAR* name, FString& outValue)
+  {
+    if (const FString* value = params.Find(name))
+      outValue = value->TrimQuotes();
+  }
+};
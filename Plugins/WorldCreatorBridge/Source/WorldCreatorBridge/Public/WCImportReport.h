@@ -0,0 +1,54 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WCSyncStats.h"
+
+// Summary of one sync, saved as json under Saved/WorldCreatorBridge/ImportReport_<timestamp>.json after every sync,
+// so import times can be compared across plugin versions and terrain sizes.
+class FWCImportReport
+{
+public:
+  static const int FILE_VERSION = 1;
+
+  FDateTime timestamp;
+  FString pluginVersion;
+  FString mapName;
+  FString terrainName;
+  // false if the sync was cancelled
+  bool bCompleted = false;
+  double totalSeconds = 0.0;
+
+  // manifest
+  float manifestVersion = 0.0f;
+  int resolutionX = 0;
+  int resolutionY = 0;
+  int tilesX = 0;
+  int tilesY = 0;
+  int tileResolution = 0;
+  int numLayers = 0;
+
+  // import, numImported and numUpdated are the changed landscapes the sync started with
+  int numUnrealTiles = 0;
+  int numImported = 0;
+  int numUpdated = 0;
+  int quadsPerSection = 0;
+  bool bImportLayers = false;
+  bool bStreamImport = false;
+  bool bUseWorldPartition = false;
+  bool bIncrementalSync = false;
+  bool bPackLayerTextures = false;
+  bool bLayerTextureArrays = false;
+
+  // stats
+  double stageSeconds[(int)EWCSyncStage::Num] = {};
+  int64 stageBytes[(int)EWCSyncStage::Num] = {};
+  int64 bytesAssembled = 0;
+  int64 bytesCopied = 0;
+  int64 peakBufferBytes = 0;
+
+  void SetStats(const FWCSyncStats& stats);
+  bool Save(const FString& filePath) const;
+
+  static FString GetFilePath(const FDateTime& timestamp);
+};
@@ -0,0 +1,49 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+// Read only view of a tile file. The file is memory mapped through IPlatformFile::OpenMapped so heightmap and
+// splatmap data can be used in place, platforms without mapping support fall back to loading the file into memory.
+// The view can be moved past a file header without copying the payload.
+class FWCMappedFile
+{
+public:
+  FWCMappedFile();
+  FWCMappedFile(FWCMappedFile&& other);
+  FWCMappedFile& operator=(FWCMappedFile&& other);
+  ~FWCMappedFile();
+
+  FWCMappedFile(const FWCMappedFile&) = delete;
+  FWCMappedFile& operator=(const FWCMappedFile&) = delete;
+
+  bool Open(const FString& filePath);
+  void Close();
+
+  // replaces the view with data that had to be decoded, e.g. a run length encoded splatmap
+  void AdoptBuffer(TArray<uint8>&& buffer);
+
+  // moves the start of the view, e.g. behind the 18 byte tga header
+  void SetViewOffset(int64 offset);
+
+  bool IsValid() const { return data != nullptr; }
+  bool IsMapped() const { return region.IsValid(); }
+  const uint8* GetData() const { return data != nullptr ? data + viewOffset : nullptr; }
+  int64 Num() const { return size - viewOffset; }
+  int64 GetFileSize() const { return size; }
+  const uint8* GetFileData() const { return data; }
+
+private:
+  // the region has to be released before the handle it was mapped from
+  TUniquePtr<IMappedFileHandle> handle;
+  TUniquePtr<IMappedFileRegion> region;
+  TArray<uint8> ownedData;
+
+  const uint8* data = nullptr;
+  int64 size = 0;
+  int64 viewOffset = 0;
+};
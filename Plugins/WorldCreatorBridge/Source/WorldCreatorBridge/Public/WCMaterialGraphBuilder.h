@@ -0,0 +1,71 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "UObject/UObjectGlobals.h"
+
+class UMaterial;
+class UMaterialExpression;
+class UTexture;
+
+// Creates the expressions of a generated material. Expressions of the same class with the same inputs and values are
+// created once and shared, so a graph that asks for the same constant, mask or coordinate math again and again only
+// contains it once. Add, Multiply and Min ignore the order of their inputs.
+// Finish removes everything the material outputs do not use and places the expressions in columns by their distance
+// from the outputs.
+class FWCMaterialGraphBuilder
+{
+public:
+  explicit FWCMaterialGraphBuilder(UMaterial* inMaterial);
+
+  UMaterialExpression* Constant(float value);
+  UMaterialExpression* Constant2(float r, float g);
+  // parameters are shared by name, the default of the first request is used
+  UMaterialExpression* ScalarParameter(FName name, float defaultValue);
+  UMaterialExpression* VectorParameter(FName name, const FLinearColor& defaultValue);
+  UMaterialExpression* LandscapeCoords();
+
+  UMaterialExpression* Add(UMaterialExpression* a, UMaterialExpression* b);
+  UMaterialExpression* Subtract(UMaterialExpression* a, UMaterialExpression* b);
+  UMaterialExpression* Multiply(UMaterialExpression* a, UMaterialExpression* b);
+  UMaterialExpression* Divide(UMaterialExpression* a, UMaterialExpression* b);
+  UMaterialExpression* Min(UMaterialExpression* a, UMaterialExpression* b);
+  UMaterialExpression* Append(UMaterialExpression* a, UMaterialExpression* b);
+  UMaterialExpression* Floor(UMaterialExpression* input);
+  UMaterialExpression* OneMinus(UMaterialExpression* input);
+  // clamps to 0..1
+  UMaterialExpression* Clamp(UMaterialExpression* input);
+  UMaterialExpression* Mask(UMaterialExpression* input, bool r, bool g, bool b = false, bool a = false);
+  UMaterialExpression* DDX(UMaterialExpression* input);
+  UMaterialExpression* DDY(UMaterialExpression* input);
+
+  UMaterialExpression* TextureSample(UTexture* texture, UMaterialExpression* coordinates, EMaterialSamplerType samplerType = SAMPLERTYPE_Color);
+  // samples with the mip level of the given uv derivatives instead of the derivatives of the coordinates
+  UMaterialExpression* TextureSampleGrad(UTexture* texture, UMaterialExpression* coordinates, UMaterialExpression* coordinatesDX, UMaterialExpression* coordinatesDY, EMaterialSamplerType samplerType = SAMPLERTYPE_Color);
+  UMaterialExpression* TextureSampleParameter(FName name, UTexture* texture, UMaterialExpression* coordinates, EMaterialSamplerType samplerType = SAMPLERTYPE_Color);
+
+  // expression that is never shared, for nodes whose inputs are filled in by the caller like layer blends
+  template<typename T>
+  T* NewExpression()
+  {
+    T* expression = NewObject<T>(GetOuter());
+    AddExpression(expression);
+    return expression;
+  }
+
+  // outputs may contain nullptr for unused material inputs
+  void Finish(const TArray<UMaterialExpression*>& outputs);
+
+private:
+  template<typename T>
+  T* FindOrCreate(const FString& key, bool& bOutCreated);
+  template<typename T>
+  UMaterialExpression* Binary(const TCHAR* name, UMaterialExpression* a, UMaterialExpression* b, bool bCommutative);
+  void AddExpression(UMaterialExpression* expression);
+  UObject* GetOuter() const;
+
+  UMaterial* material;
+  // key of the class, inputs and values of every shared expression
+  TMap<FString, UMaterialExpression*> sharedExpressions;
+};
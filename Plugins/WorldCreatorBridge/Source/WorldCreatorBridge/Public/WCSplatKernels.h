@@ -0,0 +1,49 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Row kernels that split interleaved splatmap pixels into one plane per landscape layer.
+// World Creator stores the layers of a splatmap as BGRA, the layer order is R, G, B, A.
+class FWCSplatKernels
+{
+public:
+  static const int MAX_CHANNELS = 4;
+
+  // splits count pixels of bytesPerPixel bytes into the first numChannels planes, planes that are nullptr are skipped
+  static void Deinterleave(const uint8* src, int32 count, int bytesPerPixel, int numChannels, uint8* const* planes);
+
+  static void DeinterleaveBGRA(const uint8* src, int32 count, uint8* const* planes);
+  static void DeinterleaveScalar(const uint8* src, int32 count, int bytesPerPixel, int numChannels, uint8* const* planes);
+
+  // scalar split with the pixel size known at compile time, so the stride becomes a constant
+  template<int BytesPerPixel>
+  static void DeinterleaveFixed(const uint8* src, int32 count, int numChannels, uint8* const* planes)
+  {
+    for (int c = 0; c < numChannels; c++)
+    {
+      uint8* plane = planes[c];
+      const int offset = BytesPerPixel >= 3 ? GetChannelByteOffset(c) : c;
+      if (plane == nullptr)
+        continue;
+      if (offset >= BytesPerPixel)
+      {
+        FMemory::Memzero(plane, count);
+        continue;
+      }
+
+      const uint8* in = src + offset;
+      for (int32 i = 0; i < count; i++)
+      {
+        plane[i] = in[i * BytesPerPixel];
+      }
+    }
+  }
+
+  // byte offset of a layer channel inside a BGRA pixel
+  static int GetChannelByteOffset(int channel)
+  {
+    static const int offsets[MAX_CHANNELS] = { 2, 1, 0, 3 };
+    return offsets[channel];
+  }
+};
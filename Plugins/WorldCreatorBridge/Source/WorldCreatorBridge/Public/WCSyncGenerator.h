@@ -0,0 +1,36 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FWCSyncGeneratorSettings
+{
+  FString directory;
+  // 3 writes the tiled layout (heightmap_X_Y.raw, splatmap_N_X_Y.tga), 2 the single file layout of bridge version 2.0
+  // (heightmap.raw and one tga per splatmap)
+  int version = 3;
+  int tileResolution = 1024;
+  int tilesX = 2;
+  int tilesY = 2;
+  // layers are packed four per splatmap
+  int numLayers = 4;
+  int32 seed = 0;
+};
+
+// Writes a synthetic World Creator sync folder, a Bridge.xml with the height and splatmap files it references, so the
+// import can be measured without a real export. Heights and layer weights are smooth functions of the terrain
+// position with some noise, neighbouring tiles continue each other.
+class FWCSyncGenerator
+{
+public:
+  // returns the path of the written Bridge.xml, empty if a file could not be written
+  static FString Generate(const FWCSyncGeneratorSettings& settings);
+
+  // total size of the files Generate writes for the settings
+  static int64 GetDataSize(const FWCSyncGeneratorSettings& settings);
+
+private:
+  static bool WriteHeightmap(const FString& filePath, int x0, int y0, int width, int length, bool bBottomUp, int32 seed);
+  static bool WriteSplatmap(const FString& filePath, int x0, int y0, int width, int length, int firstLayer, int numLayers, int numChannels, int32 seed);
+  static FString BuildManifest(const FWCSyncGeneratorSettings& settings, int resolutionX, int resolutionY);
+};
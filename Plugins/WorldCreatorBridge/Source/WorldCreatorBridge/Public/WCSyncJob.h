@@ -0,0 +1,60 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class SNotificationItem;
+
+// Runs a sync as a list of stages that are executed step by step from the core ticker, so the editor keeps drawing
+// and handling input between the steps. Work that does not touch UObjects (file reads, decoding, assembly) is
+// expected to run on worker tasks that the steps wait for. Progress is shown in a notification with a cancel button,
+// a cancelled job stops before its next step. Steps may add further stages, e.g. once they know how many landscapes
+// changed.
+class FWCSyncJob : public TSharedFromThis<FWCSyncJob>
+{
+public:
+  // returns false to stop the job, e.g. because the world it imports into is gone
+  typedef TFunction<bool(int step)> FStepFunction;
+  typedef TFunction<void(bool bCompleted)> FFinishFunction;
+
+  // steps are executed until this much time is used up per frame, a single step may take longer
+  static constexpr double FRAME_BUDGET_SECONDS = 0.02;
+
+  explicit FWCSyncJob(const FText& title);
+  ~FWCSyncJob();
+
+  void AddStage(const FText& name, int numSteps, FStepFunction stepFunction);
+  void Start(FFinishFunction finishFunction);
+  // runs all stages before returning, without a notification. Used by the commandlet where nothing needs to tick
+  bool Run(FFinishFunction finishFunction);
+  void Cancel();
+  // cancels and finishes the job without waiting for the next tick, e.g. when the module shuts down
+  void Stop();
+
+  bool IsRunning() const { return tickerHandle.IsValid(); }
+  bool IsCancelled() const { return bCancelled; }
+
+private:
+  struct FStage
+  {
+    FText name;
+    int numSteps = 0;
+    FStepFunction stepFunction;
+  };
+
+  bool Tick(float deltaTime);
+  void Finish(bool bCompleted);
+  void UpdateNotification();
+
+  FText title;
+  // indirect, so a step that adds stages does not move the stage it runs from
+  TIndirectArray<FStage> stages;
+  int stageIndex = 0;
+  int stepIndex = 0;
+  bool bCancelled = false;
+
+  FFinishFunction finish;
+  FTSTicker::FDelegateHandle tickerHandle;
+  TSharedPtr<SNotificationItem> notification;
+};
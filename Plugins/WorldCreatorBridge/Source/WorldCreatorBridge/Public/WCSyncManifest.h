@@ -0,0 +1,65 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FXmlNode;
+
+// one texturing layer, a channel of a splatmap
+struct FWCManifestLayer
+{
+  FString name;
+  FLinearColor color = FLinearColor::White;
+  FVector2f tileSize = FVector2f::ZeroVector;
+  FVector2f tileOffset = FVector2f::ZeroVector;
+  FString albedoFile;
+  FString normalFile;
+  FString aoFile;
+  FString displacementFile;
+  FString roughnessFile;
+};
+
+struct FWCManifestSplatmap
+{
+  // index in the splatmap file names of version 3, -1 if the manifest does not contain it
+  int index = -1;
+  // file name of the splatmap in older versions
+  FString name;
+  TArray<FWCManifestLayer> layers;
+};
+
+// Contents of a Bridge.xml. The file is parsed once per sync, every stage of the sync reads this struct instead of
+// the xml so it is shared as an immutable object with the assembly tasks. Missing attributes keep the values the
+// XmlHelper accessors return for them.
+struct FWCSyncManifest
+{
+  float version = 0.0f;
+
+  // Surface
+  float minHeight = 0.0f;
+  float maxHeight = 0.0f;
+  float height = 0.0f;
+  int width = -1;
+  int length = -1;
+  int resolutionX = -1;
+  int resolutionY = -1;
+  int tilesX = -1;
+  int tilesY = -1;
+  int tileResolution = -1;
+  int heightCenter = -1;
+
+  bool bHasTexturing = false;
+  TArray<FWCManifestSplatmap> splatmaps;
+
+  int GetNumLayers() const;
+  // xxHash64 of every value above, two manifests that import the same way have the same hash
+  uint64 GetHash() const;
+  // xxHash64 of the texturing and the layers only, the values the landscape material is built from
+  uint64 GetLayerHash() const;
+
+  // nullptr if the file cannot be read or has no Surface node
+  static TSharedPtr<const FWCSyncManifest> Load(const FString& filePath);
+
+private:
+  static void ReadLayer(const FXmlNode* node, FWCManifestLayer& outLayer);
+};
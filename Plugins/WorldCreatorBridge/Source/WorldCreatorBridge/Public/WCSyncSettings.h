@@ -0,0 +1,41 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WCTileCache.h"
+
+// Import options of a sync. The bridge window edits them through its widgets, the sync commandlet reads them from
+// the command line, both hand them to the module before the sync is started.
+struct FWCSyncSettings
+{
+  // Bridge.xml written by World Creator, empty uses the default sync folder
+  FString bridgeFilePath;
+  FString terrainName = TEXT("WC_Terrain");
+  FString terrainMaterialName = TEXT("M_Terrain");
+
+  bool bImportTextures = true;
+  bool bImportLayers = true;
+  bool bUseWorldPartition = false;
+  bool bBuildMinimap = false;
+  bool bStreamImport = false;
+  bool bIncrementalSync = true;
+  bool bUpdateInPlace = true;
+  // ambient occlusion, roughness and displacement of a layer are packed into one texture that is sampled once
+  bool bPackLayerTextures = false;
+  // the layer textures of each map type are put into one texture array, so the number of samplers of the landscape
+  // material does not grow with the number of layers
+  bool bLayerTextureArrays = false;
+
+  float worldScale = 1.0f;
+  int worldPartitionGridSize = 2;
+  int worldPartitionRegionSize = 16;
+  // maximum resolution of one unreal landscape, rounded to whole components on import
+  int landscapeResolution = 4033;
+  int quadsPerSection = 63;
+  int tileCacheBudgetMB = FWCTileCache::DEFAULT_BUDGET_MB;
+
+  static FString GetDefaultBridgeFilePath()
+  {
+    return FString::Printf(TEXT("%sWorld Creator/Sync/Bridge.xml"), FPlatformProcess::UserDir());
+  }
+};
@@ -0,0 +1,31 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Content hashes of the last sync of a terrain, saved as json under Saved/WorldCreatorBridge. A sync compares them
+// with the hashes of the current files and only re-imports the landscapes whose source tiles changed. Every hash
+// is xxHash64, files that could not be read get no hash and count as changed by the next sync.
+class FWCSyncState
+{
+public:
+  static const int FILE_VERSION = 1;
+
+  // manifest and import settings, a change invalidates every landscape
+  uint64 settingsHash = 0;
+  // heightmap and splatmaps of a World Creator tile
+  TMap<FIntPoint, uint64> tileHashes;
+  // imported texture files by path
+  TMap<FString, uint64> textureHashes;
+  // combined hash of the tiles an unreal landscape is assembled from, by landscape id
+  TMap<int, uint64> landscapeHashes;
+
+  bool Load(const FString& filePath);
+  bool Save(const FString& filePath) const;
+
+  static FString GetFilePath(const FString& mapName, const FString& terrainName);
+
+  // false if a file could not be read
+  static bool HashFile(const FString& filePath, uint64& outHash);
+  static bool HashFiles(const TArray<FString>& filePaths, uint64& outHash);
+};
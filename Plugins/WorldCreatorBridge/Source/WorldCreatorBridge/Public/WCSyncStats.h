@@ -0,0 +1,94 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include <atomic>
+
+DECLARE_STATS_GROUP(TEXT("WorldCreatorBridge"), STATGROUP_WorldCreatorBridge, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse"), STAT_WCParse, STATGROUP_WorldCreatorBridge, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Texture Import"), STAT_WCTextureImport, STATGROUP_WorldCreatorBridge, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Delete Landscapes"), STAT_WCDelete, STATGROUP_WorldCreatorBridge, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tile Read"), STAT_WCTileRead, STATGROUP_WorldCreatorBridge, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Assembly"), STAT_WCAssembly, STATGROUP_WorldCreatorBridge, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Layer Info"), STAT_WCLayerInfo, STATGROUP_WorldCreatorBridge, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Material"), STAT_WCMaterial, STATGROUP_WorldCreatorBridge, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Landscape Import"), STAT_WCLandscapeImport, STATGROUP_WorldCreatorBridge, );
+
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Bytes Read"), STAT_WCBytesRead, STATGROUP_WorldCreatorBridge, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Bytes Copied"), STAT_WCBytesCopied, STATGROUP_WorldCreatorBridge, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Buffer Memory"), STAT_WCBufferMemory, STATGROUP_WorldCreatorBridge, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Peak Buffer Memory"), STAT_WCPeakBufferMemory, STATGROUP_WorldCreatorBridge, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Tiles Processed"), STAT_WCTilesProcessed, STATGROUP_WorldCreatorBridge, );
+
+// stages of a sync that are timed by FWCSyncStats
+enum class EWCSyncStage : uint8
+{
+  Parse,
+  TextureImport,
+  Delete,
+  TileRead,
+  Assembly,
+  LayerInfo,
+  Material,
+  LandscapeImport,
+  Num
+};
+
+// Byte counters of one sync. bytesCopied counts every full copy of height, splat or file data the bridge makes on the
+// way from the World Creator files to the landscapes: tile files that are loaded instead of mapped, decoded splatmaps,
+// the assembly blits and splat planes and the data handed to the landscape import or edit interface. A change that
+// deep copies a buffer again shows up in the log.
+// Next to the counters the time and the processed bytes of every stage are summed up, stages that run on several
+// threads at once add up the time of all threads. The counters are updated by the assembly tasks, all functions are
+// thread safe. Every counter and stage is also published to STATGROUP_WorldCreatorBridge ("stat WorldCreatorBridge",
+// Unreal Insights), the callers add a TRACE_CPUPROFILER_EVENT_SCOPE next to each stage scope.
+class FWCSyncStats
+{
+public:
+  // measures a stage from construction to destruction
+  class FScopedStage
+  {
+  public:
+    FScopedStage(FWCSyncStats& stats, EWCSyncStage stage, int64 bytes = 0);
+    ~FScopedStage();
+    UE_NONCOPYABLE(FScopedStage);
+
+    void AddBytes(int64 numBytes) { bytes += numBytes; }
+
+  private:
+    FWCSyncStats& stats;
+    EWCSyncStage stage;
+    int64 bytes;
+    uint64 startCycles;
+    FScopeCycleCounter cycleCounter;
+  };
+
+  void Reset();
+
+  void AddAssembled(int64 bytes);
+  void AddCopied(int64 bytes);
+  void AddStage(EWCSyncStage stage, uint64 cycles, int64 bytes);
+  // height and splat buffers that are alive, negative when they are released
+  void AddBufferBytes(int64 bytes);
+
+  int64 GetBytesAssembled() const;
+  int64 GetBytesCopied() const;
+  double GetStageSeconds(EWCSyncStage stage) const;
+  int64 GetStageBytes(EWCSyncStage stage) const;
+  int64 GetPeakBufferBytes() const;
+
+  static const TCHAR* GetStageName(EWCSyncStage stage);
+  static TStatId GetStageStatId(EWCSyncStage stage);
+
+  void Log(const FString& terrainName) const;
+
+private:
+  std::atomic<int64> bytesAssembled{ 0 };
+  std::atomic<int64> bytesCopied{ 0 };
+  std::atomic<int64> bufferBytes{ 0 };
+  std::atomic<int64> peakBufferBytes{ 0 };
+  std::atomic<uint64> stageCycles[(int)EWCSyncStage::Num] = {};
+  std::atomic<int64> stageBytes[(int)EWCSyncStage::Num] = {};
+};
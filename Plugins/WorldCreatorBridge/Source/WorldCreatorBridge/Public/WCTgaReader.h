@@ -0,0 +1,49 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FWCTgaHeader
+{
+  static const int SIZE = 18;
+
+  uint8 idLength = 0;
+  uint8 colorMapType = 0;
+  uint8 imageType = 0;
+  uint16 colorMapLength = 0;
+  uint8 colorMapEntrySize = 0;
+  uint16 width = 0;
+  uint16 height = 0;
+  uint8 bitsPerPixel = 0;
+  uint8 descriptor = 0;
+
+  int GetBytesPerPixel() const { return bitsPerPixel / 8; }
+  bool IsRle() const { return imageType == 10 || imageType == 11; }
+  bool IsTopOrigin() const { return (descriptor & 0x20) != 0; }
+  bool IsRightOrigin() const { return (descriptor & 0x10) != 0; }
+  int64 GetPixelDataOffset() const { return SIZE + idLength + colorMapLength * ((colorMapEntrySize + 7) / 8); }
+  int64 GetImageSize() const { return (int64)width * height * GetBytesPerPixel(); }
+};
+
+// Minimal reader for the uncompressed and run length encoded true color / grayscale tga files World Creator writes
+// its splatmaps as. Decoded images are always bottom-left origin with rows from left to right, which is the layout
+// the tile assembly reads uncompressed files in.
+class FWCTgaReader
+{
+public:
+  static bool ParseHeader(const uint8* fileData, int64 fileSize, FWCTgaHeader& outHeader);
+
+  // reads only the header of the file
+  static bool Probe(const FString& filePath, FWCTgaHeader& outHeader);
+
+  // true if the pixel data behind the header can be used without decoding
+  static bool CanReadInPlace(const FWCTgaHeader& header);
+
+  // decodes the pixel data of fileData into dest, which has to hold header.GetImageSize() bytes
+  static bool Decode(const FWCTgaHeader& header, const uint8* fileData, int64 fileSize, uint8* dest);
+
+private:
+  static bool DecodeRle(const FWCTgaHeader& header, const uint8* src, const uint8* srcEnd, uint8* dest);
+  static void FlipRows(const FWCTgaHeader& header, uint8* image);
+  static void FlipColumns(const FWCTgaHeader& header, uint8* image);
+};
@@ -0,0 +1,59 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct WCLandscapeTile;
+
+// Part of a World Creator tile and the place it is copied to in the data of an unreal landscape.
+// The landscape data is column major, rows of the rect are written as columns with a stride of destStride.
+struct FWCTileRect
+{
+  const WCLandscapeTile* tile = nullptr;
+  int srcX = 0;
+  int srcY = 0;
+  int width = 0;
+  int length = 0;
+
+  uint16* heightData = nullptr;
+  // one layer per splatmap channel, indexed with splatmap * 4 + channel
+  uint8* const* splatLayers = nullptr;
+  const int* splatChannelCounts = nullptr;
+  int64 destOffset = 0;
+  int64 destStride = 0;
+
+  // MAX_CHANNELS scratch planes of the worker that executes the rect
+  TArray<uint8>* splatRows = nullptr;
+};
+
+// Copy of one World Creator tile rect into the data of an unreal landscape, the rects of a plan never overlap in
+// the destination so they can be executed in any order and in parallel.
+struct FWCBlitPlanEntry
+{
+  FIntPoint tileKey;
+  int srcX = 0;
+  int srcY = 0;
+  int width = 0;
+  int length = 0;
+  int destX = 0;
+  int destY = 0;
+};
+
+// Copies tile rects into landscape data. Everything that is fixed for a sync (file version, layer import and the
+// pixel size of the splatmaps) is a template parameter of the kernels, so the choice is made once by GetKernel
+// instead of being tested inside the copy loops.
+class FWCTileAssembly
+{
+public:
+  typedef void (*FKernel)(const FWCTileRect& rect);
+
+  static FKernel GetKernel(int version, bool bImportLayers, int bytesPerPixel);
+
+  // rows per plan entry, large tile rects are split so a single tile can still be copied by several workers
+  static const int STRIP_LENGTH = 256;
+
+  // Splits the rect at (startX, startY) of the terrain into the tile rects it is made of. Tiles are tileWidth x tileLength
+  // large, tiles at the border of the terrain are clipped to terrainWidth x terrainLength.
+  static void BuildPlan(int startX, int startY, int destWidth, int destLength, int tileWidth, int tileLength,
+    int terrainWidth, int terrainLength, TArray<FWCBlitPlanEntry>& outPlan);
+};
@@ -0,0 +1,62 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+#include "HAL/CriticalSection.h"
+#include "Async/Future.h"
+#include "WCMappedFile.h"
+
+struct WCLandscapeTile
+{
+  int width = 0;
+  int height = 0;
+  int Bpp = 0;
+  FWCMappedFile heightmap;
+  TArray<FWCMappedFile> splatmaps;
+
+  int64 GetAllocatedSize() const;
+};
+
+// Keeps decoded World Creator tiles keyed by their (tileX, tileY) position so tiles that overlap several
+// unreal landscapes are only read once per sync. The least recently used tiles are dropped as soon as the
+// cached bytes exceed the budget, tiles that are still referenced by the caller stay alive until released.
+// The cache is shared by the tile assembly tasks, all functions are thread safe. A tile that is being loaded is
+// marked as in flight, callers that need it meanwhile wait for that load, so every tile is read at most once as long
+// as it fits into the budget.
+class FWCTileCache
+{
+public:
+  static const int64 DEFAULT_BUDGET_MB = 2048;
+
+  explicit FWCTileCache(int64 budgetBytes = DEFAULT_BUDGET_MB * 1024 * 1024);
+
+  // returns the cached tile or loads it, failed loads return nullptr and are not cached
+  TSharedPtr<WCLandscapeTile> FindOrLoad(const FIntPoint& key, TFunctionRef<TSharedPtr<WCLandscapeTile>()> loader);
+  void Empty();
+
+  void SetBudget(int64 budgetBytes);
+  int64 GetBudget() const;
+  int64 GetUsedBytes() const;
+  int32 Num() const;
+
+private:
+  struct FEntry
+  {
+    TSharedPtr<WCLandscapeTile> tile;
+    int64 sizeBytes = 0;
+    uint64 lastUse = 0;
+  };
+
+  // the lock has to be held by the caller
+  void AddLocked(const FIntPoint& key, TSharedPtr<WCLandscapeTile> tile);
+  void EvictToBudget();
+
+  mutable FCriticalSection lock;
+  TMap<FIntPoint, FEntry> entries;
+  // tiles that are being loaded, set once their load finished
+  TMap<FIntPoint, TSharedFuture<TSharedPtr<WCLandscapeTile>>> loading;
+  int64 budget;
+  int64 usedBytes = 0;
+  uint64 useCounter = 0;
+};
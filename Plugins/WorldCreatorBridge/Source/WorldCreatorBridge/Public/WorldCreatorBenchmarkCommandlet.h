@@ -0,0 +1,23 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "WorldCreatorBenchmarkCommandlet.generated.h"
+
+// Generates a synthetic sync folder and imports it into a new map, then logs the wall time and throughput of every
+// stage of the import:
+//
+//   UnrealEditor-Cmd Project.uproject -run=WorldCreatorBenchmark -TileResolution=2048 -Tiles=4 -Layers=8 -nullrhi
+//
+// The map is not saved, the generated folder is deleted unless -Keep is given.
+UCLASS()
+class UWorldCreatorBenchmarkCommandlet : public UCommandlet
+{
+  GENERATED_BODY()
+
+public:
+  UWorldCreatorBenchmarkCommandlet();
+
+  virtual int32 Main(const FString& Params) override;
+};
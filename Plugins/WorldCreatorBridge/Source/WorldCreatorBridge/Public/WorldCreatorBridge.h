@@ -9,30 +9,114 @@
 #include "UObject/WeakInterfacePtr.h"
 #include "LandscapeStreamingProxy.h"
 #include "XmlHelper.h"
+#include "WCTileCache.h"
+#include "WCTgaReader.h"
+#include "WCTileAssembly.h"
+#include "WCSyncStats.h"
+#include "WCSyncManifest.h"
+#include "WCSyncState.h"
+#include "WCSyncJob.h"
+#include "WCSyncSettings.h"
+#include "Tasks/Task.h"
 #include "LandscapeSubsystem.h"
 #include "Templates/SharedPointer.h"
 
 
 class FToolBarBuilder;
 class FMenuBuilder;
+class ALandscape;
+class UTexture2DArray;
+class FWCMaterialGraphBuilder;
 #define WORLDPARTITION_MAX UE_OLD_WORLD_MAX // TODO this one changed due to the large world upgrade in unreal 5 so lets see how to fit it 
 
+// Settings and data of one landscape import. The height and layer buffers are hundreds of megabytes large, they are
+// moved in from the assembled tile and moved on into ALandscape::Import, copying the struct is not allowed.
 struct LandscapeImportData
 {
+  LandscapeImportData() = default;
+  UE_NONCOPYABLE(LandscapeImportData);
+
   int quatsPerSection;
   float scaleX, scaleY, terrainScale;
-  UMaterial* material;
+  UMaterialInterface* material;
   TArray<FLandscapeImportLayerInfo> layerInfos;
   TArray<uint16> heightData;
 };
 
-struct WCLandscapeTile
+// one unreal landscape of the synced terrain
+struct FWCUnrealTile
 {
-  int width;
-  int height;
-  int Bpp;
-  TArray<uint8> heightmap;
-  TArray<TArray<uint8>> splatmaps;
+  int tileX = 0;
+  int tileY = 0;
+  int landscapeId = 0;
+  int startX = 0;
+  int startY = 0;
+  int heightDataWidth = 0;
+  int heightDataLength = 0;
+};
+
+// height and splat data of an unreal landscape, assembled from the World Creator tiles it covers.
+// A streamed import only assembles a band of regionWidth rows starting at regionStart at a time.
+struct FWCAssembledTile
+{
+  FWCAssembledTile() = default;
+  ~FWCAssembledTile();
+  UE_NONCOPYABLE(FWCAssembledTile);
+
+  FWCUnrealTile unrealTile;
+  int regionStart = 0;
+  int regionWidth = 0;
+  TArray<uint16> heightData;
+  TArray<TArray<uint8>> splatData;
+  int numLoadedXTiles = 0;
+  int numLoadedYTiles = 0;
+  int mappingWidth = 0;
+  int mappingLength = 0;
+
+  // the buffers count as buffer memory in stats until the tile is destroyed, also when they were moved on
+  FWCSyncStats* stats = nullptr;
+  int64 bufferBytes = 0;
+};
+
+// state of a running sync job, shared by its stages
+struct FWCSyncContext
+{
+  TWeakObjectPtr<UWorld> world;
+  TSharedPtr<const FWCSyncManifest> manifest;
+  FString syncStatePath;
+  FWCSyncState syncState;
+  // the previous sync is only compared with if its settings match
+  FWCSyncState previousSyncState;
+  bool bFullSync = true;
+  // set once the tiles are compared, full syncs do not hash the files and keep no state
+  bool bSaveSyncState = false;
+  double startTime = 0.0;
+  int numUnrealTiles = 0;
+
+  // every landscape of the terrain, unrealTiles and updateTiles are picked from them once the changes are known
+  TArray<FWCUnrealTile> layoutTiles;
+  // World Creator tiles of every layout tile and all tiles that are hashed
+  TArray<TArray<FWCBlitPlanEntry>> landscapePlans;
+  TArray<TArray<FIntPoint>> landscapeTiles;
+  TArray<FIntPoint> tileKeys;
+
+  // landscapes to import and landscapes that are updated in place
+  TArray<FWCUnrealTile> unrealTiles;
+  TArray<FWCUnrealTile> updateTiles;
+  TMap<int, FIntRect> dirtyRects;
+  // changed landscapes that were not written yet, they stay marked as changed if the job is cancelled
+  TSet<int> pendingLandscapes;
+  // one task per started assembly of unrealTiles, reset once the result was taken
+  TArray<UE::Tasks::TTask<TSharedPtr<FWCAssembledTile>>> assembleTasks;
+  // one task per started assembly of the dirty rect of updateTiles
+  TArray<UE::Tasks::TTask<TSharedPtr<FWCAssembledTile>>> updateTasks;
+
+  int numSplatChannels = 0;
+  float scaleX = 100.0f;
+  float scaleY = 100.0f;
+  float terrainScale = 0.0f;
+  FVector location = FVector::ZeroVector;
+  FRotator rotation = FRotator::ZeroRotator;
 };
 
 class FWorldCreatorBridgeModule : public IModuleInterface
@@ -47,6 +131,12 @@ public:
   void PluginButtonClicked();
   void UpdateTerrainResolution(int terrainsize = -1);
 
+  void ApplySyncSettings(const FWCSyncSettings& settings);
+  // syncs the terrain into the world and returns once it is imported, used by the sync commandlet
+  bool RunSync(UWorld* world, const FWCSyncSettings& settings);
+  // counters and stage times of the last sync
+  const FWCSyncStats& GetSyncStats() const { return syncStats; }
+
 private:
 
   void RegisterMenus();
@@ -117,7 +207,8 @@ private:
   int version;
 
   // syncVariables
-  FXmlNode* root;
+  // the parsed Bridge.xml of the running sync
+  TSharedPtr<const FWCSyncManifest> manifest;
   float minHeight;
   float maxHeight;
   int width;
@@ -139,11 +230,28 @@ private:
   bool bImportLayers;  
   bool bUseWorldPartition;
   bool bBuildMinimap;
+  bool bStreamImport;
+  bool bIncrementalSync;
+  bool bUpdateInPlace;
+  bool bPackLayerTextures;
+  bool bLayerTextureArrays;
   float worldScale;
   int worldPartitionGridSize;
   int worldPartitionRegionSize;
+  int tileCacheBudgetMB;
   TSharedPtr<SEditableTextBox> selectedPathBox;
 
+  // decoded World Creator tiles of the running sync
+  FWCTileCache tileCache;
+  FWCSyncStats syncStats;
+  // landscape material of the running sync and the colormap tiles it has parameters for
+  TWeakObjectPtr<UMaterial> parentMaterial;
+  FIntPoint parentMaterialSlots = FIntPoint::ZeroValue;
+  // colormap tiles of the running sync packed into one array, the parent material has no slots if it is set
+  TWeakObjectPtr<UTexture2DArray> colormapArray;
+  bool bRefreshLandscapeMaterials = false;
+  TSharedPtr<FWCSyncJob> syncJob;
+
 private:
 
   // self written functinos 
@@ -151,24 +259,80 @@ private:
 
   // Menu button functions
   FReply SyncButtonClicked();
+  bool StartSync(UWorld* world, bool bBlocking);
+  // the sync steps read the settings members, the widgets that change them are disabled while a sync runs
+  bool IsSyncIdle() const;
   FReply BuildMinimapButtonClicked();
   FReply BrowseButtonClicked();
 
-  void ImportTextureFiles();
-  UMaterial* CreateLandscapeMaterial(int terrainId, int _numTilesX, int _numTilesY, int startX, int startY, int mappingWidth, int mappingLength);
-  void DeletePreviousImportedWorldCreatorLandscape(UWorld* world, FVector* location, FRotator* rotation);
+  // syncState is nullptr for syncs that do not record their state
+  void ImportTextureFiles(const FWCSyncState* previousSyncState, FWCSyncState* syncState);
+  UMaterial* CreateParentMaterial(int slotsX, int slotsY);
+  uint64 GetMaterialGraphHash(int slotsX, int slotsY) const;
+  void RefreshLandscapeMaterials(UWorld* world);
+  FString GetColormapArrayName() const;
+  UTexture2DArray* LoadColormapArray() const;
+  bool LoadColormapTiles(TArray<TObjectPtr<UTexture2D>>& outTextures) const;
+  static bool IsTextureArrayCurrent(const UTexture2DArray* textureArray, const TArray<TObjectPtr<UTexture2D>>& sourceTextures);
+  UTexture2DArray* CreateColormapArray();
+  UTexture2DArray* CreateTextureArray(const FString& arrayName, const TArray<TObjectPtr<UTexture2D>>& sourceTextures);
+  UTexture2D* LoadLayerTexture(FString fileName) const;
+  FString GetPackedLayerTextureName(int layerIndex) const;
+  UTexture2D* FindPackedLayerTexture(int layerIndex) const;
+  void PackLayerTextures(bool bForce);
+  UTexture2D* LoadLayerMap(const FWCManifestLayer& textureLayer, int layerIndex, int layerMap) const;
+  FString GetLayerArrayName(int layerMap) const;
+  UTexture2DArray* FindLayerArray(int layerMap) const;
+  UTexture2DArray* LoadLayerArray(int layerMap) const;
+  bool LoadLayerArrayTextures(int layerMap, TArray<TObjectPtr<UTexture2D>>& outTextures) const;
+  void CreateLayerArrays(bool bForce);
+  UMaterialExpression* CreateColormapArraySample(FWCMaterialGraphBuilder& graph, UMaterialExpression* landscapeCoords, UTexture2DArray* textureArray);
+  UMaterialInterface* CreateLandscapeMaterial(int terrainId, int _numTilesX, int _numTilesY, int startX, int startY, int mappingWidth, int mappingLength);
+  void DeletePreviousImportedWorldCreatorLandscape(UWorld* world, FVector* location, FRotator* rotation, const TSet<int>* landscapeIds = nullptr);
+  int GetImportedLandscapeId(const AActor* actor) const;
+  TMap<int, ALandscape*> FindImportedLandscapes(UWorld* world) const;
+  void PlanTileHashes(FWCSyncContext& syncContext) const;
+  void HashTiles(FWCSyncContext& syncContext, int firstTile, int numTiles) const;
+  TSet<int> FindChangedLandscapes(FWCSyncContext& syncContext) const;
+  // sorts the changed landscapes into updates and imports and adds their stages to the sync job
+  void AddImportStages(const TSharedRef<FWCSyncContext>& syncContext, TSet<int> changedLandscapes);
+  bool CanUpdateLandscapeInPlace(ALandscape* landscapeActor, const FWCUnrealTile& unrealTile, int numSplatChannels);
+  // region holds the assembled rows of the dirty rect
+  bool UpdateLandscapeInPlace(ALandscape* landscapeActor, const FWCUnrealTile& unrealTile, const FIntRect& dirtyRect, const FWCAssembledTile& region, int numSplatChannels);
+  uint64 GetSyncSettingsHash() const;
+  void LaunchAssembleTask(FWCSyncContext& syncContext);
+  void LaunchUpdateAssembleTask(FWCSyncContext& syncContext);
+  void ImportUnrealTile(FWCSyncContext& syncContext, int tileIndex);
+  void FinishSync(FWCSyncContext& syncContext, bool bCompleted);
+  void WriteImportReport(const FWCSyncContext& syncContext, bool bCompleted) const;
   void ImportHeightMapToLandscape(UWorld* world, TSharedPtr<LandscapeImportData> data, int width, int length, int id, FVector location, FRotator rotation);
+  void ImportStreamedLandscape(UWorld* world, TSharedPtr<LandscapeImportData> data, const FWCUnrealTile& unrealTile, const TArray<FWCManifestSplatmap>& splatmaps, int numSplatChannels, FVector location, FRotator rotation);
+  ALandscape* CreateStreamedLandscape(UWorld* world, TSharedPtr<LandscapeImportData> data, int width, int length, FVector location, FRotator rotation);
+  void WriteLandscapeRegion(ALandscape* landscapeActor, const FWCAssembledTile& region, const TArray<FLandscapeImportLayerInfo>& layerInfos, int x1 = 0, int x2 = -1);
+  void FinishLandscapeImport(UWorld* world, ALandscape* landscapeActor, TSharedPtr<LandscapeImportData> data, int width, int length, int id, FVector location, FRotator rotation);
+  TArray<FLandscapeImportLayerInfo> CreateLayerInfos(const FWCUnrealTile& unrealTile, int numLayers, const TArray<FWCManifestSplatmap>& splatmaps);
+  bool LoadLayerInfos(const FWCUnrealTile& unrealTile, int numLayers, TArray<FLandscapeImportLayerInfo>& outLayerInfos);
+  FString GetLayerInfoName(int layerIndex, const FWCUnrealTile& unrealTile) const;
   int RecaulculateToUnrealSize(int quadsPerSection, int size);
   bool SetupXmlVariables();
-  void AddComponents(ULandscapeInfo* InLandscapeInfo, ULandscapeSubsystem* InLandscapeSubsystem, const TArray<FIntPoint>& InComponentCoordinates, TArray<ALandscapeProxy*>& OutCreatedStreamingProxies);
+  void AddComponents(ULandscapeInfo* InLandscapeInfo, ALandscapeProxy* InLandscapeProxy, const TArray<FIntPoint>& InComponentCoordinates);
   bool CreateLandscape(int componentCountX, int componentCountY, int quadsPerSection, FVector location, FVector scale, FRotator rotation);
-  WCLandscapeTile* TileToData(FString pathEnding, TArray<FXmlNode*> texturNodes);
+  TSharedPtr<WCLandscapeTile> TileToData(int tileX, int tileY, const TArray<FWCManifestSplatmap>& splatmaps);
+  TSharedPtr<WCLandscapeTile> ReadTile(int tileX, int tileY, const TArray<FWCManifestSplatmap>& splatmaps);
+  FString GetHeightmapPath(int tileX, int tileY) const;
+  FString GetSplatmapPath(int tileX, int tileY, const FWCManifestSplatmap& splatmap) const;
+  TArray<FString> GetTileFilePaths(const FIntPoint& tileKey, const TArray<FWCManifestSplatmap>& splatmaps) const;
+  TSharedPtr<FWCAssembledTile> AssembleUnrealTile(const FWCUnrealTile& unrealTile, const TArray<FWCManifestSplatmap>& splatmaps, int numSplatChannels, int regionStart = 0, int regionWidth = -1);
+  void BuildBlitPlan(int startX, int startY, int destWidth, int destLength, TArray<FWCBlitPlanEntry>& outPlan) const;
+  void LoadPlanTiles(const TArray<FWCBlitPlanEntry>& plan, const TArray<FWCManifestSplatmap>& splatmaps, TMap<FIntPoint, TSharedPtr<WCLandscapeTile>>& outTiles, FWCAssembledTile& outTile);
+  void GetPlanLayout(const TArray<FWCBlitPlanEntry>& plan, const TArray<FWCManifestSplatmap>& splatmaps, const TMap<FIntPoint, TSharedPtr<WCLandscapeTile>>* loadedTiles, FWCAssembledTile& outTile) const;
 
   TOptional<float> GetTransformDelta() const;
   TOptional<int> GetGridSizeDelta() const;
   TOptional<int> GetRegionSizeDelta() const;
   TOptional<int> GetCutSizeDelta() const;
   TOptional<int> GetQuatPSSizeDelta() const;
+  TOptional<int> GetTileCacheBudgetDelta() const;
   TOptional<FString> GetSelectedPath() const;
 
   //TSharedRef<SWidget> GetSectionSizeMenu();
@@ -0,0 +1,23 @@
+// Copyright BiteTheBytes GmbH
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "WorldCreatorSyncCommandlet.generated.h"
+
+// Imports a World Creator sync into a map without the editor UI, e.g. for nightly terrain imports on a build machine:
+//
+//   UnrealEditor-Cmd Project.uproject -run=WorldCreatorSync -Map=/Game/Maps/Terrain -Xml=/path/to/Bridge.xml -nullrhi
+//
+// The options of the bridge window are passed as parameters, see the constructor for the full list. The map and all
+// imported assets are saved when the sync succeeds.
+UCLASS()
+class UWorldCreatorSyncCommandlet : public UCommandlet
+{
+  GENERATED_BODY()
+
+public:
+  UWorldCreatorSyncCommandlet();
+
+  virtual int32 Main(const FString& Params) override;
+};
@@ -5,42 +5,62 @@
 #include "Runtime/XmlParser/Public/XmlNode.h"
 #include "Math/Vector2D.h"
 
+// Attribute accessors that read the values in place, only GetString allocates the returned string.
+// Missing nodes and attributes return the same defaults as before.
 class XmlHelper
 {
 public:
-	static float GetFloat(FXmlNode* node, FString attributeName)
+	static const FString* FindAttribute(const FXmlNode* node, FStringView attributeName)
 	{
-		auto att = node->GetAttribute(attributeName);
-		if (att.IsEmpty())
+		if (node == nullptr)
+			return nullptr;
+		for (const FXmlAttribute& attribute : node->GetAttributes())
+		{
+			if (attributeName.Equals(attribute.GetTag(), ESearchCase::IgnoreCase))
+				return &attribute.GetValue();
+		}
+		return nullptr;
+	}
+
+	static float GetFloat(const FXmlNode* node, FStringView attributeName)
+	{
+		const FString* att = FindAttribute(node, attributeName);
+		if (att == nullptr || att->IsEmpty())
 			return 0.0f;
-		return FCString::Atof(att.GetCharArray().GetData());
+		return FCString::Atof(**att);
 	}
 
-	static void GetFloat2(FXmlNode* node, FString attributeName, float* tx, float* ty)
+	static void GetFloat2(const FXmlNode* node, FStringView attributeName, float* tx, float* ty)
 	{
-		auto att = node->GetAttribute(attributeName);
-		if (att.IsEmpty())
+		const FString* att = FindAttribute(node, attributeName);
+		if (att == nullptr || att->IsEmpty())
+			return;
+		int32 separator;
+		if (!att->FindChar(TEXT(','), separator))
+		{
+			*tx = 0.0f;
+			*ty = 0.0f;
 			return;
-		FString x, y;
-		att.Split(TEXT(","), &x, &y);
+		}
 
-		*tx = FCString::Atof(x.GetCharArray().GetData());
-		*ty = FCString::Atof(y.GetCharArray().GetData());
+		// Atof stops at the separator
+		*tx = FCString::Atof(**att);
+		*ty = FCString::Atof(**att + separator + 1);
 	}
 
-	static int GetInt(FXmlNode* node, FString attributeName)
+	static int GetInt(const FXmlNode* node, FStringView attributeName)
 	{
-		auto att = node->GetAttribute(attributeName);
-		if (att.IsEmpty())
+		const FString* att = FindAttribute(node, attributeName);
+		if (att == nullptr || att->IsEmpty())
 			return -1;
-		return FCString::Atoi(att.GetCharArray().GetData());
+		return FCString::Atoi(**att);
 	}
 
-	static FString GetString(FXmlNode* node, FString attributeName)
+	static FString GetString(const FXmlNode* node, FStringView attributeName)
 	{
-		auto att = node->GetAttribute(attributeName);
-		if (att.IsEmpty())
+		const FString* att = FindAttribute(node, attributeName);
+		if (att == nullptr)
 			return TEXT("");
-		return att;
+		return *att;
 	}
-};
\ No newline at end of file
+};
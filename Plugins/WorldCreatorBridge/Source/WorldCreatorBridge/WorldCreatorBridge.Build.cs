@@ -56,7 +56,10 @@ public class WorldCreatorBridge : ModuleRules
                 "SlateCore",
                 "AssetTools",
                 "AssetRegistry",
-                "LevelEditor"
+                "LevelEditor",
+                "Json",
+                "RHI",
+                "ImageCore"
           // ... add private dependencies that you statically link with here ...	
   }
         );